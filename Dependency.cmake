@@ -93,6 +93,10 @@ ExternalProject_Add(
     )
 set(DEP_LIST ${DEP_LIST} dep_glm)
 
+# treegen_core는 GL / GLFW / imgui / assimp 없이 spdlog, stb, glm만 사용
+set(CORE_DEP_LIST dep_spdlog dep_stb dep_glm)
+set(CORE_DEP_LIBS spdlog$<$<CONFIG:Debug>:d>)
+
 # imgui 1.82
 add_library(imgui
     imgui/imgui_draw.cpp
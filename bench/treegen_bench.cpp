@@ -0,0 +1,302 @@
+#include "tree.h"
+#include "tree_preset.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+/*
+나무 생성 파이프라인 벤치마크
+기본 preset x iteration 마다 고정된 seed로 repeat 번 실행하고 중앙값을 기록
+1. derive : MakeCodes (ns/symbol)
+2. interpret : MakeCylinderMatrices (ns/symbol, instances/s)
+3. bake : Tree::MakeMeshes + instance transform 배열 생성 (GL 업로드 직전까지, Tree::Timing::bake)
+4. export : ExportObj (MB/s)
+5. total : Create + ExportObj
+캐시는 사용하지 않음
+
+treegen_bench --iterations 1-7 --repeat 5 --json bench.json
+*/
+
+struct BenchOptions {
+    std::vector<const TreePreset*> presets;
+    int minIteration { 1 };
+    int maxIteration { 7 };
+    int repeat { 5 };
+    uint32_t seed { 1 };
+    float angle { 30.0f };
+    std::vector<float> treeParam { 0.1f, 1.0f, 0.2f, 0.2f, 0.75f, 0.75f };
+    bool sphere { false };
+    bool exportObj { true };
+    std::string jsonPath { "treegen_bench.json" };
+    std::string scratchDir { "." };
+    size_t memoryBudget { (size_t)1024 << 20 };
+};
+
+struct BenchResult {
+    std::string preset;
+    int iteration { 0 };
+    bool skipped { false };
+    size_t symbols { 0 };
+    size_t instances { 0 };
+    size_t exportBytes { 0 };
+    double deriveMs { 0.0 };
+    double interpretMs { 0.0 };
+    double bakeMs { 0.0 };
+    double exportMs { 0.0 };
+    double totalMs { 0.0 };
+    size_t peakRss { 0 };
+};
+
+using Clock = std::chrono::steady_clock;
+
+static double ElapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static double Median(std::vector<double> values) {
+    if (values.empty())
+        return 0.0;
+    std::sort(values.begin(), values.end());
+    size_t mid = values.size() / 2;
+    return values.size() % 2 ? values[mid] : 0.5 * (values[mid - 1] + values[mid]);
+}
+
+// 프로세스 전체의 최대 사용량이므로 앞선 case보다 줄어들지 않음
+static size_t GetPeakRss() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return counters.PeakWorkingSetSize;
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#ifdef __APPLE__
+    return (size_t)usage.ru_maxrss;
+#else
+    return (size_t)usage.ru_maxrss * 1024;
+#endif
+#endif
+}
+
+static BenchResult RunCase(const BenchOptions& options, const TreePreset& preset, int iteration) {
+    BenchResult result;
+    result.preset = preset.name;
+    result.iteration = iteration;
+
+    size_t estimate = Tree::EstimateMemoryUsage(preset.axiom, preset.rules, iteration, options.sphere);
+    if (estimate > options.memoryBudget) {
+        SPDLOG_ERROR("{} iteration {} needs about {} MB, over the budget of {} MB, skipped",
+            preset.name, iteration, estimate >> 20, options.memoryBudget >> 20);
+        result.skipped = true;
+        return result;
+    }
+
+    std::string path = fmt::format("{}/treegen_bench_{}.obj", options.scratchDir, preset.name);
+    std::vector<double> derive, interpret, bake, exportTime, total;
+    for (int r = 0; r < options.repeat; r++) {
+        auto start = Clock::now();
+        auto tree = Tree::Create(preset.axiom, preset.rules, options.treeParam, options.angle,
+            iteration, options.sphere, 0.0f, 0.0f, options.seed);
+        double createMs = ElapsedMs(start);
+        if (!tree) {
+            SPDLOG_ERROR("failed to create {} iteration {}", preset.name, iteration);
+            result.skipped = true;
+            return result;
+        }
+        derive.push_back(tree->GetTiming().derive);
+        interpret.push_back(tree->GetTiming().interpret);
+        bake.push_back(tree->GetTiming().bake);
+
+        double exportMs = 0.0;
+        if (options.exportObj) {
+            auto exportStart = Clock::now();
+            std::ofstream out(path, std::ios::binary);
+            tree->ExportObj(out, preset.name);
+            result.exportBytes = (size_t)out.tellp();
+            out.close();
+            exportMs = ElapsedMs(exportStart);
+            exportTime.push_back(exportMs);
+        }
+        total.push_back(createMs + exportMs);
+
+        result.symbols = tree->GetCodes().size();
+        result.instances = tree->GetCylinderTransforms().count + tree->GetLeafTransforms().count;
+    }
+    std::error_code error;
+    std::filesystem::remove(path, error);
+
+    result.deriveMs = Median(derive);
+    result.interpretMs = Median(interpret);
+    result.bakeMs = Median(bake);
+    result.exportMs = Median(exportTime);
+    result.totalMs = Median(total);
+    result.peakRss = GetPeakRss();
+    return result;
+}
+
+static double NsPerSymbol(double ms, size_t symbols) {
+    return symbols > 0 ? ms * 1e6 / (double)symbols : 0.0;
+}
+
+static double PerSecond(double count, double ms) {
+    return ms > 0.0 ? count * 1e3 / ms : 0.0;
+}
+
+static bool WriteJson(const std::string& path, const BenchOptions& options, const std::vector<BenchResult>& results) {
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        SPDLOG_ERROR("failed to open {}", path);
+        return false;
+    }
+    out << fmt::format("{{\n  \"repeat\": {},\n  \"seed\": {},\n  \"angle\": {},\n  \"sphere\": {},\n  \"results\": [\n",
+        options.repeat, options.seed, options.angle, options.sphere ? "true" : "false");
+    for (size_t i = 0; i < results.size(); i++) {
+        auto& r = results[i];
+        out << fmt::format("    {{\"preset\": \"{}\", \"iteration\": {}, \"skipped\": {}", r.preset, r.iteration,
+            r.skipped ? "true" : "false");
+        if (!r.skipped) {
+            out << fmt::format(", \"symbols\": {}, \"instances\": {}, \"export_bytes\": {}, "
+                "\"derive_ms\": {:.4f}, \"interpret_ms\": {:.4f}, \"bake_ms\": {:.4f}, \"export_ms\": {:.4f}, \"total_ms\": {:.4f}, "
+                "\"derive_ns_per_symbol\": {:.3f}, \"interpret_ns_per_symbol\": {:.3f}, \"instances_per_s\": {:.1f}, "
+                "\"export_mb_per_s\": {:.2f}, \"trees_per_s\": {:.3f}, \"peak_rss_bytes\": {}",
+                r.symbols, r.instances, r.exportBytes,
+                r.deriveMs, r.interpretMs, r.bakeMs, r.exportMs, r.totalMs,
+                NsPerSymbol(r.deriveMs, r.symbols), NsPerSymbol(r.interpretMs, r.symbols),
+                PerSecond((double)r.instances, r.interpretMs),
+                PerSecond((double)r.exportBytes / (1 << 20), r.exportMs), PerSecond(1.0, r.totalMs), r.peakRss);
+        }
+        out << (i + 1 < results.size() ? "},\n" : "}\n");
+    }
+    out << "  ]\n}\n";
+    return true;
+}
+
+static void PrintUsage() {
+    printf(
+        "usage: treegen_bench [options]\n"
+        "  --preset NAME        run only this preset, can be repeated (default: all)\n"
+        "  --iterations A[-B]   iteration range (default 1-7)\n"
+        "  --repeat N           runs per case, median is reported (default 5)\n"
+        "  --seed N             seed for every run, repeats time the same tree (default 1)\n"
+        "  --sphere             sphere leaves\n"
+        "  --no-export          skip ExportObj\n"
+        "  --json PATH          result file (default treegen_bench.json)\n"
+        "  --scratch DIR        directory for temporary OBJ files (default .)\n"
+        "  --memory-budget MB   skip cases estimated above this (default 1024)\n");
+}
+
+static bool ParseOptions(int argc, char** argv, BenchOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        auto NextValue = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                SPDLOG_ERROR("missing value for {}", arg);
+                return "";
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--help" || arg == "-h") {
+            return false;
+        }
+        else if (arg == "--preset") {
+            auto preset = FindTreePreset(NextValue());
+            if (!preset) {
+                SPDLOG_ERROR("unknown preset: {}", argv[i]);
+                return false;
+            }
+            options.presets.push_back(preset);
+        }
+        else if (arg == "--iterations") {
+            auto text = NextValue();
+            auto pos = text.find('-', 1);
+            options.minIteration = std::stoi(text.substr(0, pos));
+            options.maxIteration = pos == std::string::npos ? options.minIteration : std::stoi(text.substr(pos + 1));
+            if (options.minIteration < 0 || options.minIteration > options.maxIteration) {
+                SPDLOG_ERROR("invalid iteration range: {}", text);
+                return false;
+            }
+        }
+        else if (arg == "--repeat") {
+            options.repeat = std::max(1, std::stoi(NextValue()));
+        }
+        else if (arg == "--seed") {
+            options.seed = (uint32_t)std::stoul(NextValue());
+        }
+        else if (arg == "--sphere") {
+            options.sphere = true;
+        }
+        else if (arg == "--no-export") {
+            options.exportObj = false;
+        }
+        else if (arg == "--json") {
+            options.jsonPath = NextValue();
+        }
+        else if (arg == "--scratch") {
+            options.scratchDir = NextValue();
+        }
+        else if (arg == "--memory-budget") {
+            options.memoryBudget = (size_t)std::max(1, std::stoi(NextValue())) << 20;
+        }
+        else {
+            SPDLOG_ERROR("unknown option: {}", arg);
+            return false;
+        }
+    }
+
+    if (options.presets.empty()) {
+        for (auto& preset : GetTreePresets())
+            options.presets.push_back(&preset);
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    bool parsed = false;
+    try {
+        parsed = ParseOptions(argc, argv, options);
+    }
+    catch (const std::exception&) {
+        SPDLOG_ERROR("invalid number in arguments");
+    }
+    if (!parsed) {
+        PrintUsage();
+        return 1;
+    }
+
+    // 캐시를 쓰면 derive / interpret가 측정되지 않음
+    Tree::SetCache(nullptr);
+
+    printf("%-12s %4s %10s %10s %10s %10s %10s %12s %10s %10s\n", "preset", "iter", "symbols",
+        "derive", "interpret", "ns/sym", "inst/s", "bake ms", "MB/s", "rss MB");
+    std::vector<BenchResult> results;
+    for (auto preset : options.presets) {
+        for (int iteration = options.minIteration; iteration <= options.maxIteration; iteration++) {
+            auto result = RunCase(options, *preset, iteration);
+            if (!result.skipped) {
+                printf("%-12s %4d %10zu %10.3f %10.3f %10.2f %10.0f %12.4f %10.1f %10.1f\n",
+                    preset->name, iteration, result.symbols, result.deriveMs, result.interpretMs,
+                    NsPerSymbol(result.deriveMs + result.interpretMs, result.symbols),
+                    PerSecond((double)result.instances, result.interpretMs), result.bakeMs,
+                    PerSecond((double)result.exportBytes / (1 << 20), result.exportMs),
+                    (double)result.peakRss / (1 << 20));
+            }
+            results.push_back(std::move(result));
+        }
+    }
+
+    if (!WriteJson(options.jsonPath, options, results))
+        return 1;
+    SPDLOG_INFO("wrote {}", options.jsonPath);
+    return 0;
+}
\ No newline at end of file
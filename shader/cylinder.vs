@@ -1,23 +1,23 @@
 #version 330 core
 
 layout (location = 0) in vec3 aPos;
-// layout (location = 1) in mat4 aOffset;
 layout (location = 2) in vec2 aTexCoord;
-// out vec4 fColor;
+// instance마다 행 우선 3x4 affine (양자화한 나무 파일은 uint16 그대로, rowMinimum + q * rowScale로 복원)
+layout (location = 4) in vec4 aRow0;
+layout (location = 5) in vec4 aRow1;
+layout (location = 6) in vec4 aRow2;
 out vec2 texCoord;
 
-uniform mat4 transform;
-// uniform vec3 color;
+uniform mat4 transform;      // projection * view * 배치 위치
+uniform mat4 localTransform; // instance 행렬 뒤에 곱함 (mesh 위치 보정, position 복원)
+uniform vec4 rowMinimum[3];
+uniform vec4 rowScale[3];
 
 void main() {
-    mat4 Offset = mat4(
-        1.0, 0.0, 0.0, 0.0,
-        0.0, 1.0, 0.0, 0.0,
-        0.0, 0.0, 1.0, 0.0,
-        0.0, 0.0, 0.0, 1.0);
-    // gl_Position = transform * Offset * vec4(aPos, 1.0);
-    // gl_Position = transform * aOffset * vec4(aPos, 1.0);
-    gl_Position = transform * vec4(aPos, 1.0);
+    vec4 row0 = rowMinimum[0] + aRow0 * rowScale[0];
+    vec4 row1 = rowMinimum[1] + aRow1 * rowScale[1];
+    vec4 row2 = rowMinimum[2] + aRow2 * rowScale[2];
+    mat4 instance = transpose(mat4(row0, row1, row2, vec4(0.0, 0.0, 0.0, 1.0)));
+    gl_Position = transform * instance * localTransform * vec4(aPos, 1.0);
     texCoord = aTexCoord;
-    // fColor = vec4(color, 1.0);
-}
\ No newline at end of file
+}
@@ -18,10 +18,12 @@ void OnFramebufferSizeChange(GLFWwindow* window, int width, int height) {
 	SPDLOG_INFO("framebuffer size changed: ({} x {})", width, height);
 	auto context = reinterpret_cast<Context*>(glfwGetWindowUserPointer(window));
 	context->Reshape(width, height);
+	context->Invalidate();
 }
 // 키보드가 입력되었을 때
 void OnKeyEvent(GLFWwindow* window, int key, int scancode, int action, int mods) {
 	ImGui_ImplGlfw_KeyCallback(window, key, scancode, action, mods);
+	reinterpret_cast<Context*>(glfwGetWindowUserPointer(window))->Invalidate();
 	// SPDLOG_INFO("key: {}, scancode: {}, action: {}, mods: {}{}{}",
 	// 	key, scancode,
 	// 	action == GLFW_PRESS ? "Pressed" :
@@ -38,6 +40,7 @@ void OnKeyEvent(GLFWwindow* window, int key, int scancode, int action, int mods)
 void OnCursorPos(GLFWwindow* window, double x, double y) {
 	auto context = reinterpret_cast<Context*>(glfwGetWindowUserPointer(window));
 	context->MouseMove(x, y);
+	context->Invalidate();
 }
 void OnMouseButton(GLFWwindow* window, int button, int action, int modifier) {
 	ImGui_ImplGlfw_MouseButtonCallback(window, button, action, modifier);
@@ -45,14 +48,22 @@ void OnMouseButton(GLFWwindow* window, int button, int action, int modifier) {
 	double x, y;
 	glfwGetCursorPos(window, &x, &y);
 	context->MouseButton(button, action, x, y);
+	context->Invalidate();
 }
 
 void OnCharEvent(GLFWwindow* window, unsigned int ch) {
     ImGui_ImplGlfw_CharCallback(window, ch);
+    reinterpret_cast<Context*>(glfwGetWindowUserPointer(window))->Invalidate();
 }
 
 void OnScroll(GLFWwindow* window, double xoffset, double yoffset) {
     ImGui_ImplGlfw_ScrollCallback(window, xoffset, yoffset);
+    reinterpret_cast<Context*>(glfwGetWindowUserPointer(window))->Invalidate();
+}
+
+// 가려졌던 창이 다시 보일 때
+void OnWindowRefresh(GLFWwindow* window) {
+    reinterpret_cast<Context*>(glfwGetWindowUserPointer(window))->Invalidate();
 }
 
 void OnWindowIconify(GLFWwindow* window, int iconified) {
@@ -68,6 +79,10 @@ void OnWindowIconify(GLFWwindow* window, int iconified) {
 int main(int argc, const char** argv){
     SPDLOG_INFO("Start Program");
 
+	// glfw / glad / imgui 초기화와 동시에 Context::Init에서 쓰는 이미지 디코딩
+	// Image::Load는 디코딩이 끝난 이미지를 가져가기만 함
+	Image::SetPrefetcher(Context::PrefetchImages());
+
 	// glfw 라이브러리 초기화, 실패하면 에러 출력 후 종료
 	SPDLOG_INFO("Initialize glfw");
 	if (!glfwInit()) {
@@ -114,10 +129,12 @@ int main(int argc, const char** argv){
 	auto context = Context::Create();
 	if(!context){
 		SPDLOG_ERROR("failed to create context");
+		Image::SetPrefetcher(nullptr);
 		glfwTerminate();
 		return -1;
 	}
 	glfwSetWindowUserPointer(window, context.get());
+	// 리소스는 첫 프레임에서 만들어지므로 prefetcher는 Context가 첫 프레임 후에 해제
 
 	// 윈도우가 생성된 직후에는 해당 콜백함수가 자동으로 실행되지 않으므로 수동으로 실행
 	OnFramebufferSizeChange(window, WINDOW_WIDTH, WINDOW_HEIGHT);
@@ -130,17 +147,27 @@ int main(int argc, const char** argv){
 	glfwSetCursorPosCallback(window, OnCursorPos);
 	glfwSetMouseButtonCallback(window, OnMouseButton);
 	glfwSetScrollCallback(window, OnScroll);
+	glfwSetWindowRefreshCallback(window, OnWindowRefresh);
 
 	// glfw 루프 실행, 윈도우 close 버튼을 누르면 정상 종료
+	// 화면이 바뀔 일이 없으면 이벤트가 올 때까지 기다리고 그리지 않음 (render on demand)
+	const double IDLE_WAIT_TIMEOUT = 0.5;
 	SPDLOG_INFO("Start main loop");
 	while (!glfwWindowShouldClose(window)) {
 		// loop에서 이벤트를 수집
 		// 이벤트가 발생했을 때 호출을 무엇을 할지 콜백 함수를 통해 정의
-		glfwPollEvents();
+		if (context->NeedsRender())
+			glfwPollEvents();
+		else
+			glfwWaitEventsTimeout(IDLE_WAIT_TIMEOUT);
+
+		context->ProcessInput(window);
+		if (!context->NeedsRender())
+			continue;
+
 		ImGui_ImplGlfw_NewFrame();
     	ImGui::NewFrame();
 
-		context->ProcessInput(window);
 		context->Render();
 
 		ImGui::Render();
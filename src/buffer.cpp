@@ -19,6 +19,18 @@ void Buffer::Bind() const {
     glBindBuffer(m_bufferType, m_buffer);
 }
 
+void Buffer::SetSubData(size_t offset, const void* data, size_t size) const {
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, offset, size, data);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+void Buffer::GetSubData(size_t offset, void* data, size_t size) const {
+    glBindBuffer(GL_COPY_READ_BUFFER, m_buffer);
+    glGetBufferSubData(GL_COPY_READ_BUFFER, offset, size, data);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+}
+
 bool Buffer::Init(uint32_t bufferType, uint32_t usage,
     const void* data, size_t stride, size_t count) {
         
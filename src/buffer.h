@@ -23,6 +23,11 @@ public:
     size_t GetCount() const { return m_count; }
     void Bind() const;
 
+    // 버퍼의 일부분만 갱신, VAO에 묶인 element buffer 상태를 건드리지 않도록 COPY_WRITE 타겟 사용
+    void SetSubData(size_t offset, const void* data, size_t size) const;
+    // GPU 메모리에서 다시 읽어옴 (동기화가 일어나므로 export 등 드문 경우에만 사용)
+    void GetSubData(size_t offset, void* data, size_t size) const;
+
 private:
     Buffer() {}
     bool Init(uint32_t bufferType, uint32_t usage, const void* data, size_t stride, size_t count);
@@ -0,0 +1,124 @@
+#include "code_viewer.h"
+#include <algorithm>
+
+CodeViewerUPtr CodeViewer::Create() {
+    return CodeViewerUPtr(new CodeViewer());
+}
+
+void CodeViewer::SetText(const std::string* text) {
+    m_text = text;
+    m_lineStarts.clear();
+    m_columns = 0;
+    m_match = std::string::npos;
+    m_notFound = false;
+    m_scrollTarget = std::string::npos;
+}
+
+void CodeViewer::ComputeLines(size_t columns) {
+    m_columns = columns;
+    m_lineStarts.clear();
+    if (!m_text)
+        return;
+
+    // 가지 단위로 끊기도록 줄 끝 1/4 안에 ']'가 있으면 그 뒤에서 줄바꿈
+    const std::string& text = *m_text;
+    size_t start = 0;
+    m_lineStarts.reserve(text.size() / columns + 1);
+    while (start < text.size()) {
+        m_lineStarts.push_back((uint32_t)start);
+        size_t end = start + columns;
+        if (end >= text.size())
+            break;
+        for (size_t i = end; i > end - columns / 4; i--) {
+            if (text[i - 1] == ']') {
+                end = i;
+                break;
+            }
+        }
+        start = end;
+    }
+}
+
+size_t CodeViewer::FindLine(size_t position) const {
+    auto it = std::upper_bound(m_lineStarts.begin(), m_lineStarts.end(), (uint32_t)position);
+    return it == m_lineStarts.begin() ? 0 : (size_t)(it - m_lineStarts.begin()) - 1;
+}
+
+void CodeViewer::Draw(const char* id, const ImVec2& size) {
+    size_t length = m_text ? m_text->size() : 0;
+    ImGui::PushID(id);
+
+    // 검색 : Enter 또는 next로 현재 위치 다음 결과로 이동, 끝까지 가면 처음부터
+    bool search = ImGui::InputText("##search", m_search, sizeof(m_search), ImGuiInputTextFlags_EnterReturnsTrue);
+    ImGui::SameLine();
+    search |= ImGui::Button("next");
+    if (search && m_text && m_search[0]) {
+        size_t from = m_match == std::string::npos ? 0 : m_match + 1;
+        m_match = m_text->find(m_search, from);
+        if (m_match == std::string::npos && from > 0)
+            m_match = m_text->find(m_search);
+        m_matchLength = strlen(m_search);
+        m_scrollTarget = m_match;
+        m_notFound = m_match == std::string::npos;
+    }
+    ImGui::SameLine();
+    if (m_notFound)
+        ImGui::TextUnformatted("not found");
+    else if (m_match != std::string::npos)
+        ImGui::Text("%zu / %zu", m_match, length);
+    else
+        ImGui::Text("%zu symbols", length);
+
+    ImGui::SetNextItemWidth(120.0f);
+    if (ImGui::InputInt("jump to symbol", &m_jumpIndex, 1, 100, ImGuiInputTextFlags_EnterReturnsTrue) && length > 0) {
+        m_jumpIndex = std::clamp(m_jumpIndex, 0, (int)length - 1);
+        m_match = (size_t)m_jumpIndex;
+        m_matchLength = 1;
+        m_scrollTarget = m_match;
+        m_notFound = false;
+    }
+
+    ImGui::BeginChild("##codes", size, true, ImGuiWindowFlags_HorizontalScrollbar);
+    if (length > 0) {
+        float charWidth = ImGui::CalcTextSize("F").x;
+        size_t columns = (size_t)std::max(8.0f, ImGui::GetContentRegionAvail().x / std::max(charWidth, 1.0f));
+        if (columns != m_columns || m_lineStarts.empty())
+            ComputeLines(columns);
+
+        float lineHeight = ImGui::GetTextLineHeightWithSpacing();
+        if (m_scrollTarget != std::string::npos) {
+            ImGui::SetScrollY(FindLine(m_scrollTarget) * lineHeight);
+            m_scrollTarget = std::string::npos;
+        }
+
+        size_t matchLine = m_match == std::string::npos ? std::string::npos : FindLine(m_match);
+        const char* data = m_text->data();
+        ImGuiListClipper clipper;
+        clipper.Begin((int)m_lineStarts.size(), lineHeight);
+        while (clipper.Step()) {
+            for (int line = clipper.DisplayStart; line < clipper.DisplayEnd; line++) {
+                size_t begin = m_lineStarts[line];
+                size_t end = line + 1 < (int)m_lineStarts.size() ? m_lineStarts[line + 1] : length;
+                if ((size_t)line == matchLine) {
+                    // 찾은 문자를 기준으로 앞 / 찾은 부분 / 뒤를 나눠서 색을 다르게 그림
+                    size_t matchEnd = std::min(end, m_match + m_matchLength);
+                    if (m_match > begin) {
+                        ImGui::TextUnformatted(data + begin, data + m_match);
+                        ImGui::SameLine(0.0f, 0.0f);
+                    }
+                    ImGui::TextColored(ImVec4(1.0f, 0.8f, 0.2f, 1.0f), "%.*s", (int)(matchEnd - m_match), data + m_match);
+                    if (matchEnd < end) {
+                        ImGui::SameLine(0.0f, 0.0f);
+                        ImGui::TextUnformatted(data + matchEnd, data + end);
+                    }
+                }
+                else {
+                    ImGui::TextUnformatted(data + begin, data + end);
+                }
+            }
+        }
+        clipper.End();
+    }
+    ImGui::EndChild();
+    ImGui::PopID();
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#ifndef __CODE_VIEWER_H__
+#define __CODE_VIEWER_H__
+
+#include "common.h"
+#include <imgui.h>
+#include <vector>
+
+/*
+생성된 문자열 보기 (수 MB 문자열도 프레임 시간이 일정하도록)
+1. 문자열은 복사하지 않고 참조만 보관, SetText로 나무가 바뀔 때마다 다시 지정
+2. 줄 시작 위치는 문자열 / 창 너비가 바뀔 때만 계산 (가능하면 ']' 뒤에서 줄바꿈)
+3. ImGuiListClipper로 보이는 줄만 그림
+4. 검색, 몇 번째 문자로 이동
+*/
+CLASS_PTR(CodeViewer)
+class CodeViewer {
+public:
+    static CodeViewerUPtr Create();
+
+    // text는 다음 SetText 전까지 유효해야 함 (nullptr이면 비어있음)
+    void SetText(const std::string* text);
+    void Draw(const char* id, const ImVec2& size);
+
+private:
+    CodeViewer() {}
+    void ComputeLines(size_t columns);
+    size_t FindLine(size_t position) const;
+
+    const std::string* m_text { nullptr };
+    std::vector<uint32_t> m_lineStarts;
+    size_t m_columns { 0 };
+
+    char m_search[128] {};
+    // 강조할 구간 (검색 결과 또는 이동한 문자)
+    size_t m_match { std::string::npos };
+    size_t m_matchLength { 0 };
+    bool m_notFound { false };
+    int m_jumpIndex { 0 };
+    // 다음 Draw에서 이 문자가 있는 줄로 스크롤
+    size_t m_scrollTarget { std::string::npos };
+};
+
+#endif // __CODE_VIEWER_H__
\ No newline at end of file
@@ -1,11 +1,23 @@
 ﻿#include "context.h"
 #include "image.h"
+#include "tree_preset.h"
+#include "tree_file.h"
 #include "glm/gtx/string_cast.hpp"
 #include <iostream>
 #include <fstream>
 #include <filesystem>
 #include <tuple>
 
+namespace {
+
+// 이미지를 변환해둔 텍스쳐 파일 위치 (treegen_texconv로 미리 변환해둘 수도 있음)
+const char* TEXTURE_CACHE_DIRECTORY = "./cache/texture";
+// S3TC / RGTC로 압축 (메모리는 1/6 ~ 1/2, 화질은 조금 떨어짐)
+// S3TC를 지원하지 않으면 Texture::SetFileCacheDirectory에서 압축하지 않도록 바꿈
+const bool COMPRESS_TEXTURES = true;
+
+} // namespace
+
 ContextUPtr Context::Create(){
     auto context = ContextUPtr(new Context());
     if(!context->Init()){
@@ -14,7 +26,35 @@ ContextUPtr Context::Create(){
     return std::move(context);
 }
 
+ImagePrefetcherUPtr Context::PrefetchImages() {
+    std::vector<ImagePrefetcher::Request> requests = {
+        { "./image/marble.jpg", true },
+        { "./image/skybox/right.jpg", false },
+        { "./image/skybox/left.jpg", false },
+        { "./image/skybox/top.jpg", false },
+        { "./image/skybox/bottom.jpg", false },
+        { "./image/skybox/front.jpg", false },
+        { "./image/skybox/back.jpg", false },
+        { "./image/leaf2.png", true },
+        // 나무 / 잎 텍스쳐 (LSystem::Init에서 바로 사용)
+        { "./image/tree.png", true },
+    };
+    // 이미 변환해둔 이미지는 디코딩할 필요가 없음
+    // GL context 전이라 S3TC 지원 여부를 모르므로 압축 / 비압축 변환 파일 중 하나만 있어도 건너뜀
+    // (S3TC가 없으면 SetFileCacheDirectory가 압축하지 않도록 바꾸고 비압축 파일을 사용)
+    requests.erase(std::remove_if(requests.begin(), requests.end(), [](const ImagePrefetcher::Request& request) {
+        return TextureFile::IsUpToDate(TEXTURE_CACHE_DIRECTORY, request.filepath, request.flipVertical, true) ||
+            TextureFile::IsUpToDate(TEXTURE_CACHE_DIRECTORY, request.filepath, request.flipVertical, false);
+    }), requests.end());
+    return ImagePrefetcher::Start(requests);
+}
+
 void Context::ProcessInput(GLFWwindow* window) {
+    const int cameraKeys[] = { GLFW_KEY_W, GLFW_KEY_S, GLFW_KEY_A, GLFW_KEY_D, GLFW_KEY_Q, GLFW_KEY_E };
+    m_keyHeld = false;
+    for (auto key : cameraKeys)
+        m_keyHeld |= glfwGetKey(window, key) == GLFW_PRESS;
+
     const float cameraSpeed = 0.005f;
     if(glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
         m_cameraPos += cameraSpeed * m_cameraFront;
@@ -34,6 +74,11 @@ void Context::ProcessInput(GLFWwindow* window) {
         m_cameraPos -= cameraSpeed * cameraUp;
 }
 
+bool Context::IsAnimating() const {
+    // profiler는 프레임이 계속 있어야 의미가 있음
+    return m_cameraControl || m_keyHeld || m_treeLoader || m_modelLoader || m_showProfiler;
+}
+
 void Context::MouseMove(double x, double y) {
     if(!m_cameraControl) return;
 
@@ -71,83 +116,83 @@ void Context::Reshape(int width, int height) {
     m_height = std::max(1, height);
     glViewport(0, 0, m_width, m_height);
 
-    m_framebuffer = Framebuffer::Create(Texture::Create(width, height, GL_RGBA));
+    // 크기가 바뀌면 다음에 사용할 때 새 크기로 다시 만듦
+    m_framebuffer.Reset();
 }
 
 bool Context::Init(){
     glEnable(GL_MULTISAMPLE);
+    // 같은 입력 + seed의 나무는 디스크 캐시에서 불러옴 (실패하면 캐시 없이 동작)
+    const size_t TREE_CACHE_SIZE = (size_t)256 << 20;
+    Tree::SetCache(TreeCache::Create("./cache/tree", TREE_CACHE_SIZE));
+    Program::SetBinaryCacheDirectory("./cache/program");
+    Texture::SetFileCacheDirectory(TEXTURE_CACHE_DIRECTORY, COMPRESS_TEXTURES);
     m_box = Mesh::CreateBox();
-
-    m_simpleProgram = Program::Create("./shader/simple.vs", "./shader/simple.fs");
-    if(!m_simpleProgram) return false;
-
-    m_program = Program::Create("./shader/lighting.vs", "./shader/lighting.fs");
-    if(!m_program) return false;
-
-    m_textureProgram = Program::Create("./shader/texture.vs", "./shader/texture.fs");
-    if (!m_textureProgram) return false;
-
-    m_postProgram = Program::Create("./shader/texture.vs", "./shader/gamma.fs");
-    if (!m_postProgram) return false;
-
-    m_lightingShadowProgram = Program::Create("./shader/lighting_shadow.vs", "./shader/lighting_shadow.fs");
-    if (!m_lightingShadowProgram) return false;
-
-    m_objProgram = Program::Create("./shader/obj.vs", "./shader/obj.fs");
-    if(!m_objProgram) return false;
-
-    m_normalProgram = Program::Create("./shader/normal.vs", "./shader/normal.fs");
-    if(!m_normalProgram) return false;
+    m_profiler = FrameProfiler::Create();
+    if(!m_profiler) return false;
+
+    // 여기서는 생성 함수만 등록하고 실제 생성은 처음 Get할 때
+    m_resources = ResourceRegistry::Create();
+    auto registry = m_resources.get();
+    auto LoadProgram = [](const std::string& vertFilename, const std::string& fragFilename) {
+        return [=]() { return Program::Create(vertFilename, fragFilename); };
+    };
+    m_simpleProgram.Init(registry, "simple program", LoadProgram("./shader/simple.vs", "./shader/simple.fs"));
+    m_program.Init(registry, "lighting program", LoadProgram("./shader/lighting.vs", "./shader/lighting.fs"));
+    m_textureProgram.Init(registry, "texture program", LoadProgram("./shader/texture.vs", "./shader/texture.fs"));
+    m_postProgram.Init(registry, "post program", LoadProgram("./shader/texture.vs", "./shader/gamma.fs"));
+    m_lightingShadowProgram.Init(registry, "lighting shadow program",
+        LoadProgram("./shader/lighting_shadow.vs", "./shader/lighting_shadow.fs"));
+    m_objProgram.Init(registry, "obj program", LoadProgram("./shader/obj.vs", "./shader/obj.fs"));
+    m_normalProgram.Init(registry, "normal program", LoadProgram("./shader/normal.vs", "./shader/normal.fs"));
+    m_skyboxProgram.Init(registry, "skybox program", LoadProgram("./shader/skybox.vs", "./shader/skybox.fs"));
+    m_envMapProgram.Init(registry, "env map program", LoadProgram("./shader/env_map.vs", "./shader/env_map.fs"));
 
     glClearColor(0.0f, 0.1f, 0.2f, 0.0f);
 
-    TexturePtr grayTexture = Texture::CreateFromImage(
-        Image::CreateSingleColorImage(4, 4, glm::vec4(0.5f, 0.5f, 0.5f, 1.0f)).get());
-
-    m_planeMaterial = Material::Create();
-    m_planeMaterial->diffuse = Texture::CreateFromImage(Image::Load("./image/marble.jpg").get());
-    m_planeMaterial->specular = grayTexture;
-    m_planeMaterial->shininess = 4.0f;
+    m_planeMaterial.Init(registry, "plane material", []() {
+        auto material = Material::Create();
+        material->diffuse = Texture::Load("./image/marble.jpg");
+        material->specular = Texture::CreateFromImage(
+            Image::CreateSingleColorImage(4, 4, glm::vec4(0.5f, 0.5f, 0.5f, 1.0f)).get());
+        material->shininess = 4.0f;
+        return material;
+    });
 
     // cube texture
-    auto cubeRight = Image::Load("./image/skybox/right.jpg", false);
-    auto cubeLeft = Image::Load("./image/skybox/left.jpg", false);
-    auto cubeTop = Image::Load("./image/skybox/top.jpg", false);
-    auto cubeBottom = Image::Load("./image/skybox/bottom.jpg", false);
-    auto cubeFront = Image::Load("./image/skybox/front.jpg", false);
-    auto cubeBack = Image::Load("./image/skybox/back.jpg", false);
-    m_cubeTexture = CubeTexture::CreateFromImages({
-        cubeRight.get(),
-        cubeLeft.get(),
-        cubeTop.get(),
-        cubeBottom.get(),
-        cubeFront.get(),
-        cubeBack.get(),
+    m_cubeTexture.Init(registry, "skybox texture", []() {
+        return CubeTexture::Load({
+            "./image/skybox/right.jpg",
+            "./image/skybox/left.jpg",
+            "./image/skybox/top.jpg",
+            "./image/skybox/bottom.jpg",
+            "./image/skybox/front.jpg",
+            "./image/skybox/back.jpg",
+        });
     });
-    m_skyboxProgram = Program::Create("./shader/skybox.vs", "./shader/skybox.fs");
-    if(!m_skyboxProgram) return false;
-
-    m_envMapProgram = Program::Create("./shader/env_map.vs", "./shader/env_map.fs");
-    if(!m_envMapProgram) return false;
 
-    m_shadowMap = ShadowMap::Create(1024,1024);
+    m_shadowMap.Init(registry, "shadow map", []() { return ShadowMap::Create(1024, 1024); });
+    m_framebuffer.Init(registry, "framebuffer", [this]() {
+        return Framebuffer::Create(Texture::Create(m_width, m_height, GL_RGBA));
+    });
 
     m_lsystem = LSystem::Create("","", m_treeParam, m_angle, 0);
     if(!m_lsystem) return false;
-
-    m_lsystem2 = LSystem::Create("X", "X=F[<X][>X]", m_treeParam, m_angle, 3, 2.0f, true);
-    m_lsystem2->Move(-2.0f, -2.0f);
+    m_codeViewer = CodeViewer::Create();
+    m_codeViewer->SetText(&m_lsystem->GetCodes());
 
     return true;
 }
 
 // Main의 while문에서 반복
 void Context::Render() {
+    m_profiler->BeginFrame();
+    m_profiler->BeginPhase("ui");
     if (ImGui::BeginMainMenuBar()) {
         if(ImGui::BeginMenu("File")) {
-            if(ImGui::MenuItem("Open", "Ctrl+O")) {
-                m_fileDialogOpen.SetTitle("Select *.obj");
-                m_fileDialogOpen.SetTypeFilters({ ".obj"});
+            if(ImGui::MenuItem("Open", "Ctrl+O", false, !m_modelLoader)) {
+                m_fileDialogOpen.SetTitle("Select *.obj or *.tgtree");
+                m_fileDialogOpen.SetTypeFilters({ ".obj", ".tgtree" });
                 m_fileDialogOpen.Open();
             }
             if(ImGui::MenuItem("Save", "Ctrl+S")) {
@@ -157,9 +202,26 @@ void Context::Render() {
             }
             ImGui::EndMenu();
         }
+        // 모델 로딩 중에는 진행 상황과 취소 버튼 표시
+        if(m_modelLoader) {
+            ImGui::ProgressBar(m_modelLoader->GetProgress(), ImVec2(200.0f, 0.0f), m_modelLoader->GetStatus());
+            if(ImGui::MenuItem("Cancel"))
+                m_modelLoader->Cancel();
+        }
+        // 나무 생성 중에도 진행 상황과 취소 버튼 표시 (완료될 때까지 기존 나무를 그림)
+        if(m_treeLoader) {
+            ImGui::ProgressBar(m_treeLoader->GetProgress(), ImVec2(200.0f, 0.0f), m_treeLoader->GetStatus());
+            if(m_treeLoader->GetPreviewIteration() > 0)
+                ImGui::Text("preview: iteration %d", m_treeLoader->GetPreviewIteration());
+            if(ImGui::MenuItem("Cancel tree"))
+                m_treeLoader->Cancel();
+        }
         ImGui::EndMainMenuBar();
     }
 
+    if(m_modelLoader)
+        UpdateModelLoader();
+
     // 만약 사용자가 Open 메뉴를 선택했다면
     m_fileDialogOpen.Display();
     if(m_fileDialogOpen.HasSelected()) {
@@ -205,6 +267,9 @@ void Context::Render() {
             ImGui::SameLine();
             ImGui::Checkbox("scenery", &m_scenery);
         }
+        ImGui::Checkbox("profiler", &m_showProfiler);
+        ImGui::SameLine();
+        ImGui::Checkbox("render on demand", &m_renderOnDemand);
         ImGui::EndChild();
         ImGui::SetWindowPos(m_UIPos);
         ImGui::End();
@@ -228,7 +293,15 @@ void Context::Render() {
         ImGui::Separator();
         ImGui::DragInt("iteration", &m_iteration, 0.05f, 0, 5);
         ImGui::Checkbox("sphere leaves", &m_sphereLeaves);
+        ImGui::SameLine();
+        ImGui::Checkbox("optimize meshes", &m_optimizeMeshes);
+        ImGui::InputInt("seed", &m_seed);
+        ImGui::Checkbox("random seed", &m_randomSeed);
+        ImGui::SameLine();
+        ImGui::Checkbox("progressive preview", &m_progressivePreview);
         if(ImGui::Button("Draw")) {
+            if(m_randomSeed)
+                m_seed = (int)(std::random_device()() & 0x7fffffff);
             m_model.reset();
             // m_floor = true;
             m_newCodes = true;
@@ -246,7 +319,7 @@ void Context::Render() {
         }
         ImGui::BeginChild("child3", ImVec2(0, 0), true);
         if (ImGui::CollapsingHeader("string", ImGuiTreeNodeFlags_DefaultOpen)) {
-            ImGui::TextWrapped("%s",m_lsystem->GetCodes().c_str());
+            m_codeViewer->Draw("codes", ImVec2(0, 0));
         }
         ImGui::EndChild();
         ImGui::EndChild();
@@ -257,6 +330,9 @@ void Context::Render() {
     if(m_currentItem != CUSTOM_RULES)
         SetRules();
 
+    if(m_showProfiler)
+        m_profiler->DrawOverlay(&m_showProfiler);
+
     auto lightView = glm::lookAt(m_light.position,
         m_light.position + m_light.direction, glm::vec3(0.0f, 1.0f, 0.0f));
     auto lightProjection = m_light.directional ?
@@ -264,22 +340,43 @@ void Context::Render() {
         glm::perspective(glm::radians((m_light.cutoff[0] + m_light.cutoff[1]) * 2.0f), 1.0f, 1.0f, 20.0f);
 
     if(m_newCodes){
+        // 생성 중인 나무가 있으면 취소하고 새로 시작
+        // random seed로 만든 나무는 다시 요청될 일이 없으므로 캐시에 저장하지 않음
         m_treeParam = { m_cylinderRadius, m_cylinderHeight, m_leafRadius, m_leafHeight, m_radiusScaling, m_heightScaling };
-        m_lsystem = LSystem::Create(m_gui_axiom, m_gui_rules, m_treeParam, m_angle, m_iteration, m_sphereLeaves);
+        m_treeLoader = TreeLoader::Start(m_gui_axiom, m_gui_rules, m_treeParam, m_angle, m_iteration, m_sphereLeaves,
+            0.0f, 0.0f, (uint32_t)m_seed, m_progressivePreview,
+            m_lsystem ? m_lsystem->GetArena() : nullptr, !m_randomSeed);
         m_newCodes = false;
     }
+    if(m_treeLoader) {
+        FrameProfiler::Scope scope(m_profiler.get(), "generate");
+        UpdateTreeLoader();
+    }
+
+    // 매 프레임 사용하는 리소스, 하나라도 만들지 못했으면 장면을 그리지 않음 (에러는 생성할 때 한 번만 출력)
+    auto simpleProgram = m_simpleProgram.Get();
+    auto shadowMap = m_shadowMap.Get();
+    auto lightingShadowProgram = m_lightingShadowProgram.Get();
+    auto objProgram = m_objProgram.Get();
+    if (!simpleProgram || !shadowMap || !lightingShadowProgram || !objProgram) {
+        m_profiler->EndFrame();
+        if(m_dirtyFrames > 0)
+            m_dirtyFrames--;
+        return;
+    }
 
     // shadowMap을 만들기 위해 shadowMap에 빛의 시점에서의 장면 그리기
-    m_shadowMap->Bind();
+    m_profiler->BeginPhase("shadow");
+    shadowMap->Bind();
     glClear(GL_DEPTH_BUFFER_BIT);
     glViewport(0, 0,
-        m_shadowMap->GetShadowMap()->GetWidth(),
-        m_shadowMap->GetShadowMap()->GetHeight());
-    m_simpleProgram->Use();
-    m_simpleProgram->SetUniform("color", glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
+        shadowMap->GetShadowMap()->GetWidth(),
+        shadowMap->GetShadowMap()->GetHeight());
+    simpleProgram->Use();
+    simpleProgram->SetUniform("color", glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
 
-    DrawScene(lightProjection, lightView, m_simpleProgram.get()); // 빛의 위치에서 depth 값을 렌더링
-    DrawTree(lightProjection, lightView, m_simpleProgram.get(), m_simpleProgram.get());
+    DrawScene(lightProjection, lightView, simpleProgram); // 빛의 위치에서 depth 값을 렌더링
+    DrawTree(lightProjection, lightView, simpleProgram, simpleProgram);
 
     Framebuffer::BindToDefault(); // 렌더링 종료, 원래 프로그램으로 복귀
     glViewport(0, 0, m_width, m_height);
@@ -301,14 +398,17 @@ void Context::Render() {
         m_cameraPos + m_cameraFront,
         m_cameraUp);
     
-    if(m_scenery) {
+    m_profiler->BeginPhase("skybox");
+    auto skyboxProgram = m_scenery ? m_skyboxProgram.Get() : nullptr;
+    auto cubeTexture = m_scenery ? m_cubeTexture.Get() : nullptr;
+    if(skyboxProgram && cubeTexture) {
         auto skyboxModelTransform =
             glm::translate(glm::mat4(1.0), m_cameraPos) * glm::scale(glm::mat4(1.0), glm::vec3(50.0f));
-        m_skyboxProgram->Use();
-        m_cubeTexture->Bind();
-        m_skyboxProgram->SetUniform("skybox", 0);
-        m_skyboxProgram->SetUniform("transform", projection * view * skyboxModelTransform);
-        m_box->Draw(m_skyboxProgram.get());
+        skyboxProgram->Use();
+        cubeTexture->Bind();
+        skyboxProgram->SetUniform("skybox", 0);
+        skyboxProgram->SetUniform("transform", projection * view * skyboxModelTransform);
+        m_box->Draw(skyboxProgram);
     }
 
     glm::vec3 lightPos = m_light.position;
@@ -318,125 +418,206 @@ void Context::Render() {
     if(!m_light.directional){
         auto lightModelTransform = glm::translate(glm::mat4(1.0), m_light.position) *
             glm::scale(glm::mat4(1.0), glm::vec3(0.1f));
-        m_simpleProgram->Use();
-        m_simpleProgram->SetUniform("color", glm::vec4(m_light.ambient + m_light.diffuse, 1.0f));
-        m_simpleProgram->SetUniform("transform", projection * view * lightModelTransform);
-        m_box->Draw(m_simpleProgram.get());
+        simpleProgram->Use();
+        simpleProgram->SetUniform("color", glm::vec4(m_light.ambient + m_light.diffuse, 1.0f));
+        simpleProgram->SetUniform("transform", projection * view * lightModelTransform);
+        m_box->Draw(simpleProgram);
     }
 
     // camera & light
-    m_lightingShadowProgram->Use();
-    m_lightingShadowProgram->SetUniform("viewPos", m_cameraPos);
-    m_lightingShadowProgram->SetUniform("light.directional", m_light.directional ? 1 : 0);
-    m_lightingShadowProgram->SetUniform("light.position", m_light.position);
-    m_lightingShadowProgram->SetUniform("light.direction", m_light.direction);
-    m_lightingShadowProgram->SetUniform("light.cutoff", glm::vec2(
+    m_profiler->BeginPhase("scene");
+    lightingShadowProgram->Use();
+    lightingShadowProgram->SetUniform("viewPos", m_cameraPos);
+    lightingShadowProgram->SetUniform("light.directional", m_light.directional ? 1 : 0);
+    lightingShadowProgram->SetUniform("light.position", m_light.position);
+    lightingShadowProgram->SetUniform("light.direction", m_light.direction);
+    lightingShadowProgram->SetUniform("light.cutoff", glm::vec2(
         cosf(glm::radians(m_light.cutoff[0])),
         cosf(glm::radians(m_light.cutoff[0] + m_light.cutoff[1]))));
-    m_lightingShadowProgram->SetUniform("light.attenuation", GetAttenuationCoeff(m_light.distance));
-    m_lightingShadowProgram->SetUniform("light.ambient", m_light.ambient);
-    m_lightingShadowProgram->SetUniform("light.diffuse", m_light.diffuse);
-    m_lightingShadowProgram->SetUniform("light.specular", m_light.specular);
-    m_lightingShadowProgram->SetUniform("blinn", (m_blinn ? 1 : 0));
-    m_lightingShadowProgram->SetUniform("lightTransform", lightProjection * lightView);
+    lightingShadowProgram->SetUniform("light.attenuation", GetAttenuationCoeff(m_light.distance));
+    lightingShadowProgram->SetUniform("light.ambient", m_light.ambient);
+    lightingShadowProgram->SetUniform("light.diffuse", m_light.diffuse);
+    lightingShadowProgram->SetUniform("light.specular", m_light.specular);
+    lightingShadowProgram->SetUniform("blinn", (m_blinn ? 1 : 0));
+    lightingShadowProgram->SetUniform("lightTransform", lightProjection * lightView);
     glActiveTexture(GL_TEXTURE3);
-    m_shadowMap->GetShadowMap()->Bind();
-    m_lightingShadowProgram->SetUniform("shadowMap", 3);
+    shadowMap->GetShadowMap()->Bind();
+    lightingShadowProgram->SetUniform("shadowMap", 3);
     glActiveTexture(GL_TEXTURE0);
 
-    DrawScene(projection, view, m_lightingShadowProgram.get());
+    DrawScene(projection, view, lightingShadowProgram);
+    m_profiler->BeginPhase("tree");
     DrawTree(projection, view, m_logProgram.get(), m_leafProgram.get());
-    DrawObj(projection, view, m_objProgram.get());
+    m_profiler->BeginPhase("obj");
+    DrawObj(projection, view, objProgram);
+    m_profiler->EndFrame();
+
+    // 첫 프레임까지 실제로 만든 리소스 목록, 가져가지 않은 이미지는 해제
+    if(!m_resourceTraceLogged) {
+        m_resources->LogTrace();
+        m_resourceTraceLogged = true;
+        Image::SetPrefetcher(nullptr);
+    }
+
+    if(m_dirtyFrames > 0)
+        m_dirtyFrames--;
 }
 
 void Context::SetRules() {
+    const TreePreset* preset = nullptr;
     switch(m_currentItem) {
     case CUSTOM_RULES:
 
         break;
 
     case ARROW_TREE:
-        strcpy_s(m_gui_axiom, sizeof(m_gui_axiom), "FFA");
-        strcpy_s(m_gui_rules, sizeof(m_gui_rules),
-            "A=F[--&&FC][++&&FC][--^FC][++^FC]\n"
-            "C=F[--<&&FC]||[++>&&FC]||[+<^^FC]||[->^^FC]");
+        preset = FindTreePreset("ARROW_TREE");
         break;
 
     case STOCHASTIC:
-        strcpy_s(m_gui_axiom, sizeof(m_gui_axiom), "FFA");
-        strcpy_s(m_gui_rules, sizeof(m_gui_rules),
-            "A=F++++[&&FC]++++[&&FC]++++[^FC]++++[^FC]\n"\
-            "A=F----[&&FC]----[&&FC]----[^FC]----[^FC]\n"\
-            "C=|F[--<&&FC]||[++>&&FFC]||[+<^^FC]||[->^^FFC]\n"\
-            "C=F[--<&&FFC]||[++>&&FC]||[+<^^FFC]||[->^^FC]");
+        preset = FindTreePreset("STOCHASTIC");
         break;
 
     case BUSH_LIKE:
-        strcpy_s(m_gui_axiom, sizeof(m_gui_axiom), "FFA");
-        strcpy_s(m_gui_rules, sizeof(m_gui_rules),
-            "A=[C]++++[C]++++[C]\n"\
-            "C=&FFA");
+        preset = FindTreePreset("BUSH_LIKE");
         break;
 
     case BINARYTREE:
-        strcpy_s(m_gui_axiom, sizeof(m_gui_axiom), "X");
-        strcpy_s(m_gui_rules, sizeof(m_gui_rules), "X=F[<X][>X]");
+        preset = FindTreePreset("BINARYTREE");
         break;
 
     default:
         break;
     }
+
+    if(preset) {
+        strcpy_s(m_gui_axiom, sizeof(m_gui_axiom), preset->axiom);
+        strcpy_s(m_gui_rules, sizeof(m_gui_rules), preset->rules);
+    }
 }
 
 // 회전 후 이동 -> 이동행렬 * 회전행렬 (순서)
 void Context::DrawTree(const glm::mat4& projection, const glm::mat4& view, const Program* treeProgram, const Program* leafProgram) {
     glEnable(GL_BLEND);
     m_lsystem->Draw(projection, view);
-    // m_lsystem2->Draw(projection, view);
 }
 
 void Context::Clear() {
     // m_stochastic = false;
     strcpy_s(m_gui_axiom, sizeof(m_gui_axiom), "");
     strcpy_s(m_gui_rules, sizeof(m_gui_rules), "");
-    LSystem::Create(m_gui_axiom, m_gui_rules, m_treeParam, m_angle, 0);
     m_currentItem = CUSTOM_RULES;
     m_newCodes = true;
 }
 
-void Context::OpenObject(ImGui::FileBrowser file) {
-    m_model.reset();
+// 파싱과 디코딩은 워커 스레드에서, 업로드는 UpdateModelLoader에서 프레임마다 나눠서 진행
+void Context::OpenObject(const ImGui::FileBrowser& file) {
     std::string selected = file.GetSelected().string();
     std::size_t pos = selected.rfind('.');
     std::string tex = selected.substr(0,pos);
 
     SPDLOG_INFO("File location : {}", selected);
-    m_model = Model::Load(selected);
-    if(!m_model) {
-        // 모델이 생성되지 않았을 때 처리하는 코드
-        SPDLOG_ERROR("Failed to open obj : {}", selected);
-        m_model.reset();
+
+    if(std::filesystem::path(selected).extension() == ".tgtree") {
+        if(!OpenTree(selected))
+            SPDLOG_ERROR("Failed to open tree : {}", selected);
         return;
     }
 
-    m_floor = false;
     // 동일한 이름의 텍스쳐 파일이 있을 경우 텍스쳐 지정
-    if(std::filesystem::exists(tex+".png")) {
+    if(std::filesystem::exists(tex+".png"))
         tex+=".png";
-        m_modelTexture = Texture::CreateFromImage(Image::Load(tex, false).get());
-    }
-    else if(std::filesystem::exists(tex+".jpg")) {
+    else if(std::filesystem::exists(tex+".jpg"))
         tex+=".jpg";
-        m_modelTexture = Texture::CreateFromImage(Image::Load(tex, false).get());
+    else
+        tex.clear();
+
+    m_modelLoader = ModelLoader::Start(selected, tex, m_optimizeMeshes);
+}
+
+// 나무 파일은 매핑만 하므로 바로 불러옴 (transform은 복사 없이 instance buffer로 업로드)
+bool Context::OpenTree(const std::string& filename) {
+    auto tree = Tree::CreateFromFile(TreeFile::Open(filename));
+    if(!tree)
+        return false;
+
+    // 파일의 생성 입력값을 UI에 넣어서 Draw로 같은 나무를 다시 생성할 수 있게 함
+    auto treeParam = tree->GetTreeParam();
+    m_gui_radius = treeParam[0];
+    m_gui_length = treeParam[1];
+    m_gui_leaf_radius = treeParam[2];
+    m_gui_leaf_height = treeParam[3];
+    m_radiusScaling = treeParam[4];
+    m_heightScaling = treeParam[5];
+    m_gui_angle = tree->GetAngle();
+    m_iteration = tree->GetIteration();
+    m_sphereLeaves = tree->IsSphere();
+    m_seed = (int)tree->GetSeed();
+    m_randomSeed = false;
+    snprintf(m_gui_axiom, sizeof(m_gui_axiom), "%s", tree->GetAxiom().c_str());
+    snprintf(m_gui_rules, sizeof(m_gui_rules), "%s", tree->GetRules().c_str());
+    m_currentItem = CUSTOM_RULES;
+
+    // 생성 중인 나무가 있으면 취소 (끝나면 불러온 나무를 덮어씀)
+    m_treeLoader.reset();
+    auto lsystem = LSystem::CreateFromTree(std::move(tree), m_lsystem.get(), m_optimizeMeshes);
+    if(!lsystem)
+        return false;
+    m_lsystem = std::move(lsystem);
+    m_codeViewer->SetText(&m_lsystem->GetCodes());
+    m_model.reset();
+    Invalidate();
+    return true;
+}
+
+void Context::UpdateModelLoader() {
+    auto state = m_modelLoader->Update();
+    if(state == ModelLoader::State::Done) {
+        m_model = m_modelLoader->TakeModel();
+        m_modelTexture = m_modelLoader->TakeTexture();
+        if(!m_modelTexture)
+            m_modelTexture = Texture::CreateFromImage(Image::CreateSingleColorImage(4, 4, glm::vec4(1.0f, 1.0f, 1.0f, 1.0f)).get());
+        m_modelLoader.reset();
+
+        m_floor = false;
+        Clear();
+        Invalidate();
     }
-    else {
-        m_modelTexture = Texture::CreateFromImage(Image::CreateSingleColorImage(4, 4, glm::vec4(1.0f, 1.0f, 1.0f, 1.0f)).get());
+    else if(state == ModelLoader::State::Failed) {
+        // 모델이 생성되지 않았을 때 처리하는 코드
+        SPDLOG_ERROR("Failed to open obj : {}", m_modelLoader->GetFilename());
+        m_modelLoader.reset();
     }
+    else if(state == ModelLoader::State::Cancelled) {
+        SPDLOG_INFO("Cancelled opening obj : {}", m_modelLoader->GetFilename());
+        m_modelLoader.reset();
+    }
+}
 
-    Clear();
+void Context::UpdateTreeLoader() {
+    auto state = m_treeLoader->Update(m_lsystem.get(), m_optimizeMeshes);
+    // 완성된 나무, 또는 생성 중인 중간 iteration 나무가 있으면 바로 교체
+    auto lsystem = m_treeLoader->TakeLSystem();
+    if(lsystem) {
+        m_lsystem = std::move(lsystem);
+        m_codeViewer->SetText(&m_lsystem->GetCodes());
+        // UI는 이미 그렸으므로 새 문자열은 다음 프레임에 표시
+        Invalidate();
+    }
+    if(state == TreeLoader::State::Done) {
+        m_treeLoader.reset();
+    }
+    else if(state == TreeLoader::State::Failed) {
+        SPDLOG_ERROR("Failed to generate tree");
+        m_treeLoader.reset();
+    }
+    else if(state == TreeLoader::State::Cancelled) {
+        SPDLOG_INFO("Cancelled tree generation");
+        m_treeLoader.reset();
+    }
 }
 
-void Context::SaveObject(ImGui::FileBrowser file, const LSystemUPtr& tree) {
+void Context::SaveObject(const ImGui::FileBrowser& file, const LSystemUPtr& tree) {
     if(tree->isEmpty()) {
         SPDLOG_ERROR("Create tree object before saving *.obj");
         return;
@@ -458,7 +639,7 @@ void Context::SaveObject(ImGui::FileBrowser file, const LSystemUPtr& tree) {
         SPDLOG_INFO("File saved : {}", selected + "\\" + filename);
 }
 
-bool Context::WriteToFile(std::string selected, std::string filename, const LSystemUPtr& tree) {
+bool Context::WriteToFile(const std::string& selected, const std::string& filename, const LSystemUPtr& tree) {
     std::ofstream outObj(selected + "\\" + filename + ".obj");
     std::ofstream outMtl(selected + "\\" + filename + ".mtl");
     std::string texturePath = selected + "/" + filename + ".png";
@@ -489,7 +670,8 @@ void Context::DrawObj(const glm::mat4& projection, const glm::mat4& view, const
 
 void Context::DrawScene(const glm::mat4& projection, const glm::mat4& view, const Program* program) {
     // 바닥
-    if(m_floor){
+    auto planeMaterial = m_floor ? m_planeMaterial.Get() : nullptr;
+    if(planeMaterial){
         program->Use();
         auto modelTransform =
             glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, -1.0f, 0.0f)) *
@@ -497,7 +679,7 @@ void Context::DrawScene(const glm::mat4& projection, const glm::mat4& view, cons
         auto transform = projection * view * modelTransform;
         program->SetUniform("transform", transform);
         program->SetUniform("modelTransform", modelTransform);
-        m_planeMaterial->SetToProgram(program);
+        planeMaterial->SetToProgram(program);
         m_box->Draw(program);
     }
 }
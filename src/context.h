@@ -7,12 +7,17 @@
 #include "buffer.h"
 #include "vertex_layout.h"
 #include "texture.h"
+#include "image_prefetcher.h"
 #include "mesh.h"
 #include "model.h"
+#include "model_loader.h"
 #include "framebuffer.h"
 #include "shadow_map.h"
-#include "matrix_stack.h"
 #include "lsystem.h"
+#include "tree_loader.h"
+#include "code_viewer.h"
+#include "frame_profiler.h"
+#include "resource_registry.h"
 #include <imgui.h>
 #include "imfilebrowser.h"
 
@@ -20,7 +25,17 @@ CLASS_PTR(Context)
 class Context{
 public:
     static ContextUPtr Create();
+    // 첫 프레임까지 사용하는 이미지를 미리 디코딩 시작 (GL 초기화 전에 호출)
+    static ImagePrefetcherUPtr PrefetchImages();
     void Render();
+
+    // 입력 후 ImGui 상태가 안정될 때까지 몇 프레임 더 그림
+    static const int DIRTY_FRAME_COUNT = 3;
+    // 화면이 바뀔 수 있는 일이 생기면 호출 (입력 이벤트, 창 크기 변경 등)
+    void Invalidate(int frames = DIRTY_FRAME_COUNT) { m_dirtyFrames = std::max(m_dirtyFrames, frames); }
+    // 카메라 이동 중이거나 로딩 중이면 매 프레임 그려야 함
+    bool IsAnimating() const;
+    bool NeedsRender() const { return !m_renderOnDemand || IsAnimating() || m_dirtyFrames > 0; }
     void ProcessInput(GLFWwindow* window);
     void Reshape(int width, int height);
     void MouseMove(double x, double y);
@@ -34,17 +49,24 @@ private:
     Context(){}
     bool Init();
     void Clear();
-    void OpenObject(ImGui::FileBrowser file);
-    void SaveObject(ImGui::FileBrowser file, const LSystemUPtr& tree);
+    void OpenObject(const ImGui::FileBrowser& file);
+    bool OpenTree(const std::string& filename);
+    void UpdateModelLoader();
+    void UpdateTreeLoader();
+    void SaveObject(const ImGui::FileBrowser& file, const LSystemUPtr& tree);
     // bool WriteToFile(std::ofstream& out);
-    bool WriteToFile(std::string selected, std::string filename, const LSystemUPtr& tree);
+    bool WriteToFile(const std::string& selected, const std::string& filename, const LSystemUPtr& tree);
     void SetRules();
 
-    ProgramUPtr m_program;
-    ProgramUPtr m_simpleProgram;
-    ProgramUPtr m_textureProgram;
-    ProgramUPtr m_postProgram;
-    ProgramUPtr m_objProgram;
+    // 아래 LazyResource는 처음 사용할 때 만들고 m_resources에 기록
+    ResourceRegistryUPtr m_resources;
+    bool m_resourceTraceLogged { false };
+
+    LazyResource<Program> m_program;
+    LazyResource<Program> m_simpleProgram;
+    LazyResource<Program> m_textureProgram;
+    LazyResource<Program> m_postProgram;
+    LazyResource<Program> m_objProgram;
     MeshUPtr m_box;
 
     // tree program
@@ -52,29 +74,30 @@ private:
     ProgramUPtr m_logProgram;
 
     // normal map
-    ProgramUPtr m_normalProgram;
+    LazyResource<Program> m_normalProgram;
 
     // material parameter
-    MaterialPtr m_planeMaterial;
+    LazyResource<Material> m_planeMaterial;
     MaterialPtr m_box1Material;
     MaterialPtr m_branchMaterial;
     MaterialPtr m_leafMaterial;
     MaterialPtr m_objMaterial;
 
     // framebuffer
-    FramebufferUPtr m_framebuffer;
+    LazyResource<Framebuffer> m_framebuffer;
 
     ModelUPtr m_model;
     TexturePtr m_modelTexture;
+    ModelLoaderUPtr m_modelLoader;
 
     // cubemap
-    CubeTextureUPtr m_cubeTexture;
-    ProgramUPtr m_skyboxProgram;
-    ProgramUPtr m_envMapProgram;
+    LazyResource<CubeTexture> m_cubeTexture;
+    LazyResource<Program> m_skyboxProgram;
+    LazyResource<Program> m_envMapProgram;
 
     // shadow map
-    ShadowMapUPtr m_shadowMap;
-    ProgramUPtr m_lightingShadowProgram;
+    LazyResource<ShadowMap> m_shadowMap;
+    LazyResource<Program> m_lightingShadowProgram;
 
     // tree
     bool m_newCodes { false };
@@ -89,7 +112,8 @@ private:
     float m_angle { 30.0f };
     std::vector<float> m_treeParam { m_cylinderRadius, m_cylinderHeight, m_leafRadius, m_leafHeight, m_radiusScaling, m_heightScaling };
     LSystemUPtr m_lsystem;
-    LSystemUPtr m_lsystem2;
+    TreeLoaderUPtr m_treeLoader;
+    CodeViewerUPtr m_codeViewer;
 
     // light parameter
     struct Light {
@@ -105,6 +129,15 @@ private:
     Light m_light;
     bool m_blinn { false };
 
+    // profiler
+    FrameProfilerUPtr m_profiler;
+    bool m_showProfiler { false };
+
+    // render on demand : 변경이 없으면 main loop가 이벤트를 기다리고 그리지 않음
+    bool m_renderOnDemand { true };
+    int m_dirtyFrames { DIRTY_FRAME_COUNT };
+    bool m_keyHeld { false };
+
     // clear color
     glm::vec4 m_clearColor { glm::vec4(0.1f, 0.2f, 0.3f, 0.0f) };
 
@@ -132,6 +165,11 @@ private:
     std::string m_axiom { m_gui_axiom };
     std::string m_rules { m_gui_rules };
     bool m_sphereLeaves { false };
+    int m_seed { 0 };
+    bool m_randomSeed { true };
+    bool m_progressivePreview { true };
+    // 새로 만드는 나무 / 불러오는 모델의 MeshOptions::optimize
+    bool m_optimizeMeshes { true };
 
     enum Rule {
         CUSTOM_RULES,
@@ -0,0 +1,222 @@
+#include "core_common.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+std::optional<std::string> LoadTextFile(const std::string& filename) {
+	std::ifstream fin(filename);
+	if (!fin.is_open()) {
+		SPDLOG_ERROR("failed to open file: {}", filename);
+		// optional 타입에 return할 것이 없는 경우 {} 사용
+		return {};
+	}
+	std::stringstream text;
+	text << fin.rdbuf();
+	return text.str();
+}
+
+// distance를 입력했을 때 kc, kl, kq로 이루어진 vec3를 리턴
+glm::vec3 GetAttenuationCoeff(float distance) {
+	const auto linear_coeff = glm::vec4(8.4523112e-05, 4.4712582e+00, -1.8516388e+00, 3.3955811e+01);
+	const auto quad_coeff = glm::vec4(-7.6103583e-04, 9.0120201e+00, -1.1618500e+01, 1.0000464e+02);
+
+	float kc = 1.0f;
+	float d = 1.0f / distance;
+	auto dvec = glm::vec4(1.0f, d, d*d, d*d*d);
+	float kl = glm::dot(linear_coeff, dvec);
+	float kq = glm::dot(quad_coeff, dvec);
+	
+	return glm::vec3(kc, glm::max(kl, 0.0f), glm::max(kq*kq, 0.0f));
+}
+
+float RandomRange(float minValue, float maxValue) {
+  	return ((float)rand() / (float)RAND_MAX) * (maxValue - minValue) + minValue;
+}
+
+uint64_t HashBytes(const void* data, size_t size) {
+	uint64_t hash = 14695981039346656037ull;
+	auto bytes = (const unsigned char*)data;
+	for (size_t i = 0; i < size; i++) {
+		hash ^= bytes[i];
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+bool WriteFileAtomic(const std::string& path, std::initializer_list<std::string_view> chunks) {
+	// 같은 디렉토리를 여러 프로세스가 같이 쓸 수 있으므로 임시 파일 이름에 pid와 스레드를 모두 넣음
+#ifdef _WIN32
+	int pid = _getpid();
+#else
+	int pid = (int)getpid();
+#endif
+	std::string tempPath = fmt::format("{}.{}.{}.tmp", path, pid, std::hash<std::thread::id>()(std::this_thread::get_id()));
+	bool written = false;
+	{
+		std::ofstream out(tempPath, std::ios::binary);
+		if (out.is_open()) {
+			for (auto chunk : chunks)
+				out.write(chunk.data(), chunk.size());
+			out.close();
+			written = !out.fail();
+		}
+	}
+	std::error_code error;
+	if (!written) {
+		SPDLOG_ERROR("failed to write file: {}", tempPath);
+		std::filesystem::remove(tempPath, error);
+		return false;
+	}
+	std::filesystem::rename(tempPath, path, error);
+	if (error) {
+		SPDLOG_ERROR("failed to rename file: {} -> {}", tempPath, path);
+		std::filesystem::remove(tempPath, error);
+		return false;
+	}
+	return true;
+}
+
+namespace {
+
+// ParallelFor에서 사용하는 워커 스레드 (처음 사용할 때 만들고 프로그램이 끝날 때까지 재사용)
+class WorkerPool {
+public:
+	static WorkerPool& Get() {
+		static WorkerPool pool;
+		return pool;
+	}
+	~WorkerPool() {
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_condition.notify_all();
+		for (auto& worker : m_workers)
+			worker.join();
+	}
+
+	// 호출한 스레드 포함
+	size_t GetThreadCount() const { return m_workers.size() + 1; }
+
+	// task(0) ~ task(count - 1)를 워커와 호출한 스레드가 나눠서 실행하고 모두 끝날 때까지 대기
+	// task에서 던진 예외는 (처음 하나만) 호출한 스레드에서 다시 던짐
+	void Run(size_t count, const std::function<void(size_t)>& task) {
+		auto job = std::make_shared<Job>();
+		job->task = &task;
+		job->count = count;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_jobs.push_back(job);
+		}
+		m_condition.notify_all();
+
+		while (RunTask(*job)) {}
+		{
+			std::unique_lock<std::mutex> lock(job->mutex);
+			job->condition.wait(lock, [&] { return job->finished == job->count; });
+		}
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto it = std::find(m_jobs.begin(), m_jobs.end(), job);
+			if (it != m_jobs.end())
+				m_jobs.erase(it);
+		}
+		if (job->error)
+			std::rethrow_exception(job->error);
+	}
+
+private:
+	struct Job {
+		const std::function<void(size_t)>* task { nullptr };
+		size_t count { 0 };
+		std::atomic<size_t> next { 0 };
+		size_t finished { 0 };
+		std::exception_ptr error;
+		std::mutex mutex;
+		std::condition_variable condition;
+	};
+
+	WorkerPool() {
+		size_t threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+		for (size_t i = 1; i < threadCount; i++)
+			m_workers.emplace_back(&WorkerPool::WorkerMain, this);
+	}
+
+	// 남은 task를 하나 가져가서 실행, 다 가져갔으면 false
+	static bool RunTask(Job& job) {
+		size_t index = job.next++;
+		if (index >= job.count)
+			return false;
+		std::exception_ptr error;
+		try {
+			(*job.task)(index);
+		}
+		catch (...) {
+			error = std::current_exception();
+		}
+		std::lock_guard<std::mutex> lock(job.mutex);
+		if (error && !job.error)
+			job.error = error;
+		if (++job.finished == job.count)
+			job.condition.notify_all();
+		return true;
+	}
+
+	void WorkerMain() {
+		while (true) {
+			std::shared_ptr<Job> job;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_condition.wait(lock, [&] { return m_stop || !m_jobs.empty(); });
+				if (m_stop)
+					return;
+				job = m_jobs.front();
+				// task를 모두 가져간 job은 큐에서 뺌 (끝나기를 기다리는 것은 호출한 스레드)
+				if (job->next >= job->count) {
+					m_jobs.pop_front();
+					continue;
+				}
+			}
+			while (RunTask(*job)) {}
+		}
+	}
+
+	std::vector<std::thread> m_workers;
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::deque<std::shared_ptr<Job>> m_jobs;
+	bool m_stop { false };
+};
+
+} // namespace
+
+void ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn) {
+	if (count == 0)
+		return;
+	auto& pool = WorkerPool::Get();
+	size_t threadCount = std::min(pool.GetThreadCount(), (count + grain - 1) / std::max<size_t>(grain, 1));
+	if (threadCount <= 1) {
+		fn(0, count);
+		return;
+	}
+
+	size_t step = (count + threadCount - 1) / threadCount;
+	size_t taskCount = (count + step - 1) / step;
+	pool.Run(taskCount, [&](size_t index) {
+		size_t begin = index * step;
+		fn(begin, std::min(count, begin + step));
+	});
+}
@@ -0,0 +1,61 @@
+#ifndef __CORE_COMMON_H__
+#define __CORE_COMMON_H__
+
+// GL / GLFW 없이 쓰는 공통 헤더 (treegen_core 라이브러리)
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <initializer_list>
+#include <optional>
+#include <functional>
+#include <vector>
+#include <spdlog/spdlog.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+// type aliasing
+#define CLASS_PTR(klassName) \
+class klassName; \
+using klassName ## UPtr = std::unique_ptr<klassName>; \
+using klassName ## Ptr = std::shared_ptr<klassName>; \
+using klassName ## WPtr = std::weak_ptr<klassName>;
+
+// optinal -> 파일을 읽지 못하는 경우를 포인터 없이 편리하게 사용 가능
+std::optional<std::string> LoadTextFile(const std::string& filename);
+glm::vec3 GetAttenuationCoeff(float distance);
+float RandomRange(float minValue = 0.0f, float maxValue = 1.0f);
+// FNV-1a 64bit (플랫폼, 실행마다 같은 값이므로 캐시 파일 이름에 사용)
+uint64_t HashBytes(const void* data, size_t size);
+// chunks를 이어서 path에 저장, 다른 스레드 / 프로세스가 쓰다 만 파일을 읽지 않도록 임시 파일에 쓰고 이름을 바꿈
+// 쓰기에 실패하면 (디스크 부족 등) 임시 파일을 지우고 false
+bool WriteFileAtomic(const std::string& path, std::initializer_list<std::string_view> chunks);
+
+// [0, count) 구간을 코어 수만큼 나눠서 병렬로 fn(begin, end) 실행
+// grain 보다 작은 작업은 나누지 않고 호출한 스레드에서 바로 실행
+// 워커 스레드는 한 번 만들어서 재사용, fn에서 던진 예외는 호출한 스레드에서 다시 던짐
+void ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn);
+
+// 복사 없이 연속된 메모리를 가리키는 읽기용 view (C++17에는 std::span이 없음)
+template <typename T>
+class Span {
+public:
+    Span() {}
+    Span(T* data, size_t size) : m_data(data), m_size(size) {}
+    template <typename U>
+    Span(const std::vector<U>& vector) : m_data(vector.data()), m_size(vector.size()) {}
+
+    T* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    T* begin() const { return m_data; }
+    T* end() const { return m_data + m_size; }
+    T& operator[](size_t i) const { return m_data[i]; }
+
+private:
+    T* m_data { nullptr };
+    size_t m_size { 0 };
+};
+
+#endif // __CORE_COMMON_H__
\ No newline at end of file
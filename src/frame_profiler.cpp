@@ -0,0 +1,214 @@
+#include "frame_profiler.h"
+#include <imgui.h>
+#include <algorithm>
+#include <fstream>
+
+static size_t s_drawCalls = 0;
+static size_t s_triangles = 0;
+static size_t s_instances = 0;
+
+FrameProfilerUPtr FrameProfiler::Create() {
+    auto profiler = FrameProfilerUPtr(new FrameProfiler());
+    if (!profiler->Init())
+        return nullptr;
+    return std::move(profiler);
+}
+
+bool FrameProfiler::Init() {
+    m_startTime = Clock::now();
+    return true;
+}
+
+FrameProfiler::~FrameProfiler() {
+    for (auto& phase : m_phases)
+        glDeleteQueries(QUERY_RING_SIZE, phase.queries);
+}
+
+// 프로파일러 생성 시점부터의 시간 (us, Chrome trace 단위)
+double FrameProfiler::Now() const {
+    return std::chrono::duration<double, std::micro>(Clock::now() - m_startTime).count();
+}
+
+void FrameProfiler::CountDraw(uint32_t primitiveType, size_t indexCount, size_t instanceCount) {
+    s_drawCalls++;
+    s_instances += instanceCount;
+    if (primitiveType == GL_TRIANGLES)
+        s_triangles += indexCount / 3 * instanceCount;
+    else if ((primitiveType == GL_TRIANGLE_STRIP || primitiveType == GL_TRIANGLE_FAN) && indexCount >= 3)
+        s_triangles += (indexCount - 2) * instanceCount;
+}
+
+void FrameProfiler::BeginFrame() {
+    double now = Now();
+    if (m_frame > 0) {
+        // 이전 프레임 전체 시간 (swap, ImGui 렌더링 포함)
+        m_frameHistory[(m_frame - 1) % HISTORY_SIZE] = (float)((now - m_frameStart) / 1000.0);
+        m_trace.push_back({ "frame", FRAME_TRACK, m_frameStart, now - m_frameStart });
+    }
+    m_frame++;
+    m_frameStart = now;
+
+    m_drawCalls = s_drawCalls;
+    m_triangles = s_triangles;
+    m_instances = s_instances;
+    s_drawCalls = s_triangles = s_instances = 0;
+
+    CollectQueries();
+    int slot = (int)(m_frame % HISTORY_SIZE);
+    for (auto& phase : m_phases) {
+        phase.cpuHistory[slot] = 0.0f;
+        phase.gpuHistory[slot] = 0.0f;
+    }
+}
+
+void FrameProfiler::EndFrame() {
+    if (m_activePhase >= 0)
+        EndPhase();
+    while (m_trace.size() > MAX_TRACE_EVENTS)
+        m_trace.pop_front();
+}
+
+// 결과가 준비되지 않았으면 기다리지 않고 false
+bool FrameProfiler::ReadQuery(Phase& phase, int slot) {
+    GLint available = 0;
+    glGetQueryObjectiv(phase.queries[slot], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available)
+        return false;
+    GLuint64 elapsed = 0;
+    glGetQueryObjectui64v(phase.queries[slot], GL_QUERY_RESULT, &elapsed);
+    phase.pending[slot] = false;
+    phase.gpuHistory[phase.frame[slot] % HISTORY_SIZE] += (float)(elapsed / 1.0e6);
+    m_trace.push_back({ phase.name, GPU_TRACK, phase.submitTime[slot], elapsed / 1.0e3 });
+    return true;
+}
+
+void FrameProfiler::CollectQueries() {
+    for (auto& phase : m_phases) {
+        for (int i = 0; i < QUERY_RING_SIZE; i++) {
+            if (phase.pending[i] && phase.frame[i] != m_frame)
+                ReadQuery(phase, i);
+        }
+    }
+}
+
+void FrameProfiler::BeginPhase(const char* name) {
+    if (m_activePhase >= 0)
+        EndPhase();
+
+    auto it = std::find_if(m_phases.begin(), m_phases.end(), [&](const Phase& phase) {
+        return phase.name == name || strcmp(phase.name, name) == 0;
+    });
+    if (it == m_phases.end()) {
+        Phase phase;
+        phase.name = name;
+        glGenQueries(QUERY_RING_SIZE, phase.queries);
+        m_phases.push_back(phase);
+        it = m_phases.end() - 1;
+    }
+    m_activePhase = (int)(it - m_phases.begin());
+    auto& phase = *it;
+    phase.cpuStart = Now();
+
+    // 한 프레임에 같은 단계가 두 번 나오면 CPU 시간만 누적
+    m_queryActive = phase.lastFrame != m_frame;
+    if (!m_queryActive)
+        return;
+    phase.lastFrame = m_frame;
+
+    int slot = (int)(m_frame % QUERY_RING_SIZE);
+    // QUERY_RING_SIZE 프레임이 지나도 결과가 없으면 기다리지 않고 버림
+    if (phase.pending[slot] && !ReadQuery(phase, slot))
+        m_droppedQueries++;
+    phase.pending[slot] = true;
+    phase.frame[slot] = m_frame;
+    phase.submitTime[slot] = phase.cpuStart;
+    glBeginQuery(GL_TIME_ELAPSED, phase.queries[slot]);
+}
+
+void FrameProfiler::EndPhase() {
+    if (m_activePhase < 0)
+        return;
+    auto& phase = m_phases[m_activePhase];
+    if (m_queryActive)
+        glEndQuery(GL_TIME_ELAPSED);
+    double now = Now();
+    phase.cpuHistory[m_frame % HISTORY_SIZE] += (float)((now - phase.cpuStart) / 1000.0);
+    m_trace.push_back({ phase.name, CPU_TRACK, phase.cpuStart, now - phase.cpuStart });
+    m_activePhase = -1;
+    m_queryActive = false;
+}
+
+void FrameProfiler::DrawOverlay(bool* open) {
+    if (!ImGui::Begin("Profiler", open, ImGuiWindowFlags_AlwaysAutoResize)) {
+        ImGui::End();
+        return;
+    }
+
+    // 최근 프레임 평균, 진행 중인 프레임과 (GPU는) 아직 결과가 없을 수 있는 프레임은 제외
+    auto Average = [&](const float* history, int skip) {
+        float sum = 0.0f;
+        int count = 0;
+        for (uint64_t k = skip; k < HISTORY_SIZE && k < m_frame; k++, count++)
+            sum += history[(m_frame - k) % HISTORY_SIZE];
+        return count > 0 ? sum / (float)count : 0.0f;
+    };
+    int current = (int)(m_frame % HISTORY_SIZE);
+
+    float frameMs = Average(m_frameHistory, 1);
+    ImGui::Text("frame %.2f ms (%.0f fps)", frameMs, frameMs > 0.0f ? 1000.0f / frameMs : 0.0f);
+    ImGui::PlotLines("##frame", m_frameHistory, HISTORY_SIZE, current, nullptr, 0.0f, FLT_MAX, ImVec2(300.0f, 40.0f));
+    ImGui::Text("draw calls %zu, triangles %zu, instances %zu", m_drawCalls, m_triangles, m_instances);
+
+    if (ImGui::BeginTable("phases", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("phase");
+        ImGui::TableSetupColumn("cpu ms");
+        ImGui::TableSetupColumn("gpu ms");
+        ImGui::TableHeadersRow();
+        for (auto& phase : m_phases) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(phase.name);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", Average(phase.cpuHistory, 1));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", Average(phase.gpuHistory, QUERY_RING_SIZE));
+        }
+        ImGui::EndTable();
+    }
+    if (m_droppedQueries > 0)
+        ImGui::Text("dropped gpu queries: %zu", m_droppedQueries);
+
+    char filename[256];
+    snprintf(filename, sizeof(filename), "%s", m_traceFilename.c_str());
+    if (ImGui::InputText("##trace", filename, sizeof(filename)))
+        m_traceFilename = filename;
+    ImGui::SameLine();
+    if (ImGui::Button("save trace")) {
+        if (WriteChromeTrace(m_traceFilename))
+            SPDLOG_INFO("saved frame trace: {} ({} events)", m_traceFilename, m_trace.size());
+    }
+    ImGui::End();
+}
+
+bool FrameProfiler::WriteChromeTrace(const std::string& filename) const {
+    std::ofstream out(filename);
+    if (!out.is_open()) {
+        SPDLOG_ERROR("failed to open trace file: {}", filename);
+        return false;
+    }
+
+    const char* trackNames[] = { "frame", "cpu", "gpu" };
+    out << "{\"traceEvents\":[\n";
+    for (int track = FRAME_TRACK; track <= GPU_TRACK; track++) {
+        out << fmt::format("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"{}\"}}}},\n",
+            track, trackNames[track]);
+    }
+    // GPU 이벤트의 시작 시간은 명령을 제출한 CPU 시점
+    for (size_t i = 0; i < m_trace.size(); i++) {
+        auto& event = m_trace[i];
+        out << fmt::format("{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}{}\n",
+            event.name, event.track, event.start, event.duration, i + 1 < m_trace.size() ? "," : "");
+    }
+    out << "]}\n";
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+#ifndef __FRAME_PROFILER_H__
+#define __FRAME_PROFILER_H__
+
+#include "common.h"
+#include <chrono>
+#include <deque>
+#include <vector>
+
+/*
+프레임 단계별 CPU / GPU 시간 측정
+1. CPU : BeginPhase ~ EndPhase 사이의 시간 (Scope로 감싸서 사용)
+2. GPU : 단계마다 GL_TIME_ELAPSED 쿼리를 QUERY_RING_SIZE 프레임 분량 돌려쓰고,
+   결과가 준비된 것만 다음 프레임들에서 읽어서 GPU를 기다리지 않음
+3. 최근 프레임의 이벤트를 남겨두고 필요할 때 Chrome trace JSON으로 저장 (chrome://tracing, Perfetto)
+GL_TIME_ELAPSED 쿼리는 동시에 하나만 가능하므로 단계는 중첩하지 않음
+*/
+CLASS_PTR(FrameProfiler)
+class FrameProfiler {
+public:
+    static const int QUERY_RING_SIZE = 3;
+    static const int HISTORY_SIZE = 120;
+    static const size_t MAX_TRACE_EVENTS = 200000;
+
+    static FrameProfilerUPtr Create();
+    ~FrameProfiler();
+
+    void BeginFrame();
+    void EndFrame();
+    // name은 문자열 상수 (포인터를 그대로 보관), 진행 중인 단계가 있으면 먼저 끝냄
+    void BeginPhase(const char* name);
+    void EndPhase();
+
+    // Mesh::Draw에서 호출, 이번 프레임의 draw call / 삼각형 / 인스턴스 수 집계
+    static void CountDraw(uint32_t primitiveType, size_t indexCount, size_t instanceCount = 1);
+
+    void DrawOverlay(bool* open);
+    bool WriteChromeTrace(const std::string& filename) const;
+
+    class Scope {
+    public:
+        Scope(FrameProfiler* profiler, const char* name) : m_profiler(profiler) { m_profiler->BeginPhase(name); }
+        ~Scope() { m_profiler->EndPhase(); }
+    private:
+        FrameProfiler* m_profiler;
+    };
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    FrameProfiler() {}
+    bool Init();
+    double Now() const;
+
+    struct Phase {
+        const char* name;
+        uint32_t queries[QUERY_RING_SIZE] {};
+        // 쿼리 결과를 기다리는 중인 slot과 해당 프레임의 정보
+        bool pending[QUERY_RING_SIZE] {};
+        uint64_t frame[QUERY_RING_SIZE] {};
+        double submitTime[QUERY_RING_SIZE] {};
+        uint64_t lastFrame { UINT64_MAX };
+        double cpuStart { 0.0 };
+        float cpuHistory[HISTORY_SIZE] {};
+        float gpuHistory[HISTORY_SIZE] {};
+    };
+    struct TraceEvent {
+        const char* name;
+        int track;
+        double start;
+        double duration;
+    };
+    enum Track { FRAME_TRACK, CPU_TRACK, GPU_TRACK };
+
+    bool ReadQuery(Phase& phase, int slot);
+    void CollectQueries();
+
+    Clock::time_point m_startTime;
+    uint64_t m_frame { 0 };
+    double m_frameStart { 0.0 };
+    float m_frameHistory[HISTORY_SIZE] {};
+    std::vector<Phase> m_phases;
+    int m_activePhase { -1 };
+    bool m_queryActive { false };
+    size_t m_droppedQueries { 0 };
+
+    size_t m_drawCalls { 0 };
+    size_t m_triangles { 0 };
+    size_t m_instances { 0 };
+
+    std::deque<TraceEvent> m_trace;
+    std::string m_traceFilename { "frame_trace.json" };
+};
+
+#endif // __FRAME_PROFILER_H__
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include "generation_arena.h"
+#include <cstdlib>
+#include <new>
+
+// alignment는 2의 거듭제곱
+static size_t AlignOffset(const uint8_t* base, size_t offset, size_t alignment) {
+    uintptr_t address = ((uintptr_t)base + offset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    return (size_t)(address - (uintptr_t)base);
+}
+
+GenerationArenaUPtr GenerationArena::Create(size_t blockSize) {
+    auto arena = GenerationArenaUPtr(new GenerationArena());
+    arena->m_blockSize = std::max<size_t>(blockSize, 4096);
+    return std::move(arena);
+}
+
+GenerationArena::~GenerationArena() {
+    ReleaseBlocks();
+}
+
+GenerationArena::Lease::Lease(GenerationArena* arena) : m_arena(arena) {
+    if (!m_arena)
+        return;
+    m_arena->m_leaseMutex.lock();
+    m_arena->Reset();
+}
+
+GenerationArena::Lease::~Lease() {
+    if (m_arena)
+        m_arena->m_leaseMutex.unlock();
+}
+
+void GenerationArena::Reset() {
+    size_t reserved = GetReservedSize();
+    if (reserved > MAX_RETAINED_SIZE) {
+        ReleaseBlocks();
+    }
+    else if (m_blocks.size() > 1) {
+        // 다음 생성도 비슷한 크기일 것이므로 연속된 블록 하나로 준비
+        ReleaseBlocks();
+        AddBlock(reserved);
+    }
+    m_current = 0;
+    m_offset = 0;
+}
+
+size_t GenerationArena::GetUsedSize() const {
+    size_t size = m_offset;
+    for (size_t i = 0; i < m_current && i < m_blocks.size(); i++)
+        size += m_blocks[i].size;
+    return size;
+}
+
+size_t GenerationArena::GetReservedSize() const {
+    size_t size = 0;
+    for (auto& block : m_blocks)
+        size += block.size;
+    return size;
+}
+
+void GenerationArena::AddBlock(size_t size) {
+    auto data = (uint8_t*)malloc(size);
+    if (!data)
+        throw std::bad_alloc();
+    m_blocks.push_back({ data, size });
+}
+
+void GenerationArena::ReleaseBlocks() {
+    for (auto& block : m_blocks)
+        free(block.data);
+    m_blocks.clear();
+    m_current = 0;
+    m_offset = 0;
+}
+
+void* GenerationArena::do_allocate(size_t bytes, size_t alignment) {
+    while (m_current < m_blocks.size()) {
+        auto& block = m_blocks[m_current];
+        size_t offset = AlignOffset(block.data, m_offset, alignment);
+        if (offset + bytes <= block.size) {
+            m_offset = offset + bytes;
+            return block.data + offset;
+        }
+        // 남은 공간은 버리고 다음 블록 (Reset 이후 되감은 경우 이미 있는 블록 재사용)
+        m_current++;
+        m_offset = 0;
+    }
+
+    size_t size = m_blocks.empty() ? m_blockSize : m_blocks.back().size * 2;
+    AddBlock(std::max(size, bytes + alignment));
+    m_current = m_blocks.size() - 1;
+    auto& block = m_blocks.back();
+    size_t offset = AlignOffset(block.data, 0, alignment);
+    m_offset = offset + bytes;
+    return block.data + offset;
+}
\ No newline at end of file
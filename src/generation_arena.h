@@ -0,0 +1,61 @@
+#ifndef __GENERATION_ARENA_H__
+#define __GENERATION_ARENA_H__
+
+#include "core_common.h"
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+/*
+나무 한 번 생성하는 동안만 쓰는 임시 데이터용 monotonic arena (std::pmr::memory_resource)
+1. 할당은 현재 블록에서 위치만 증가, deallocate는 아무것도 하지 않음
+2. Reset은 블록을 해제하지 않고 처음으로 되감음 -> 다시 생성할 때는 malloc이 거의 없음
+3. 블록이 부족하면 이전 블록의 2배 (요청이 더 크면 요청 크기) 블록 추가
+   블록이 여러 개가 된 다음 Reset에서는 전체 크기의 블록 하나로 합침
+Lease로 한 번에 한 생성만 사용 (이전 생성이 끝날 때까지 대기)
+*/
+CLASS_PTR(GenerationArena)
+class GenerationArena : public std::pmr::memory_resource {
+public:
+    static const size_t DEFAULT_BLOCK_SIZE = (size_t)64 << 10;
+    // Reset 할 때 이보다 많이 잡고 있으면 모두 해제 (아주 큰 나무를 만든 다음)
+    static const size_t MAX_RETAINED_SIZE = (size_t)256 << 20;
+
+    static GenerationArenaUPtr Create(size_t blockSize = DEFAULT_BLOCK_SIZE);
+    ~GenerationArena();
+
+    // 잡고 있는 동안 다른 Lease는 대기, 잡을 때 Reset (arena가 nullptr이면 아무것도 안 함)
+    class Lease {
+    public:
+        Lease(GenerationArena* arena);
+        ~Lease();
+    private:
+        GenerationArena* m_arena;
+    };
+
+    void Reset();
+    size_t GetUsedSize() const;
+    size_t GetReservedSize() const;
+    size_t GetBlockCount() const { return m_blocks.size(); }
+
+private:
+    GenerationArena() {}
+    void AddBlock(size_t size);
+    void ReleaseBlocks();
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* /*p*/, size_t /*bytes*/, size_t /*alignment*/) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    struct Block {
+        uint8_t* data;
+        size_t size;
+    };
+    std::vector<Block> m_blocks;
+    size_t m_blockSize { DEFAULT_BLOCK_SIZE };
+    size_t m_current { 0 };
+    size_t m_offset { 0 };
+    std::mutex m_leaseMutex;
+};
+
+#endif // __GENERATION_ARENA_H__
\ No newline at end of file
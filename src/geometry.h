@@ -0,0 +1,16 @@
+#ifndef __GEOMETRY_H__
+#define __GEOMETRY_H__
+
+#include "core_common.h"
+#include "mesh_data.h"
+
+// 기본 도형의 vertex / index 데이터 생성 (GL 없음, Mesh::CreateXXX에서 GPU로 업로드)
+MeshData MakeBoxMeshData();
+MeshData MakePlaneMeshData();
+MeshData MakeCylinderMeshData(float radius = 0.5f, float height = 1.0f, float rate = 1.0f);
+MeshData MakeLeafMeshData(float width = 0.1f, float height = 0.1f);
+MeshData MakeSphereMeshData(float radius = 0.1f);
+
+void ComputeTangents(std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
+
+#endif // __GEOMETRY_H__
\ No newline at end of file
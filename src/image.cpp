@@ -1,10 +1,27 @@
 #include "image.h"
+#include "image_prefetcher.h"
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb/stb_image.h>
 #include <stb/stb_image_write.h>
 #include <string>
 
+static ImagePrefetcherPtr s_prefetcher;
+
+void Image::SetPrefetcher(ImagePrefetcherPtr prefetcher) {
+    std::atomic_store(&s_prefetcher, prefetcher);
+}
+
 ImageUPtr Image::Load(const std::string& filepath, bool flipVertical) {
+    auto prefetcher = std::atomic_load(&s_prefetcher);
+    if (prefetcher) {
+        auto image = prefetcher->Take(filepath, flipVertical);
+        if (image)
+            return std::move(image);
+    }
+    return Decode(filepath, flipVertical);
+}
+
+ImageUPtr Image::Decode(const std::string& filepath, bool flipVertical) {
     auto image = ImageUPtr(new Image());
     if (!image->LoadWithStb(filepath, flipVertical))
         return nullptr;
@@ -12,7 +29,8 @@ ImageUPtr Image::Load(const std::string& filepath, bool flipVertical) {
 }
 
 bool Image::LoadWithStb(const std::string& filepath, bool flipVertical) {
-    stbi_set_flip_vertically_on_load(flipVertical);
+    // 워커 스레드에서도 디코딩하므로 스레드별 flip 설정 사용
+    stbi_set_flip_vertically_on_load_thread(flipVertical);
     m_data = stbi_load(filepath.c_str(), &m_width, &m_height, &m_channelCount, 0);
     if (!m_data) {
         SPDLOG_ERROR("failed to load image: {}", filepath);
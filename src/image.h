@@ -1,12 +1,18 @@
 #ifndef __IMAGE_H__
 #define __IMAGE_H__
 
-#include "common.h"
+#include "core_common.h"
 
 CLASS_PTR(Image)
+CLASS_PTR(ImagePrefetcher)
 class Image {
 public:
+    // prefetcher가 등록되어 있고 미리 디코딩한 이미지면 그것을 사용, 아니면 Decode
     static ImageUPtr Load(const std::string& filepath, bool flipVertical = true);
+    // 항상 파일에서 디코딩
+    static ImageUPtr Decode(const std::string& filepath, bool flipVertical = true);
+    // nullptr이면 사용 안 함, 여러 스레드에서 Load를 호출해도 됨
+    static void SetPrefetcher(ImagePrefetcherPtr prefetcher);
     static ImageUPtr Create(int width, int height, int channelCount = 4);
     static ImageUPtr CreateSingleColorImage(int width, int height, const glm::vec4& color);
     ~Image();
@@ -0,0 +1,57 @@
+#include "image_prefetcher.h"
+#include <algorithm>
+
+ImagePrefetcherUPtr ImagePrefetcher::Start(const std::vector<Request>& requests, int threadCount) {
+    auto prefetcher = ImagePrefetcherUPtr(new ImagePrefetcher());
+    for (auto& request : requests) {
+        Entry entry;
+        entry.request = request;
+        prefetcher->m_entries.push_back(std::move(entry));
+    }
+
+    if (threadCount <= 0)
+        threadCount = (int)std::max(1u, std::thread::hardware_concurrency());
+    threadCount = std::min(threadCount, (int)requests.size());
+    for (int i = 0; i < threadCount; i++)
+        prefetcher->m_workers.emplace_back(&ImagePrefetcher::Run, prefetcher.get());
+    return std::move(prefetcher);
+}
+
+ImagePrefetcher::~ImagePrefetcher() {
+    for (auto& worker : m_workers)
+        worker.join();
+}
+
+// 워커 스레드 : 아직 시작하지 않은 이미지를 하나씩 가져가서 디코딩
+void ImagePrefetcher::Run() {
+    while (true) {
+        size_t index;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_next >= m_entries.size())
+                return;
+            index = m_next++;
+        }
+        // 등록된 prefetcher를 다시 찾지 않도록 Decode로 직접 디코딩
+        auto& request = m_entries[index].request;
+        auto image = Image::Decode(request.filepath, request.flipVertical);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_entries[index].image = std::move(image);
+            m_entries[index].done = true;
+        }
+        m_doneCondition.notify_all();
+    }
+}
+
+ImageUPtr ImagePrefetcher::Take(const std::string& filepath, bool flipVertical) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto it = std::find_if(m_entries.begin(), m_entries.end(), [&](const Entry& entry) {
+        return !entry.taken && entry.request.flipVertical == flipVertical && entry.request.filepath == filepath;
+    });
+    if (it == m_entries.end())
+        return nullptr;
+    it->taken = true;
+    m_doneCondition.wait(lock, [&] { return it->done; });
+    return std::move(it->image);
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#ifndef __IMAGE_PREFETCHER_H__
+#define __IMAGE_PREFETCHER_H__
+
+#include "image.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+이미지 미리 디코딩
+1. Start에서 요청한 이미지를 코어 수만큼의 스레드로 나눠서 바로 디코딩 시작
+2. Take는 해당 이미지의 디코딩이 끝날 때까지만 기다렸다가 넘겨줌 (요청하지 않은 이미지면 nullptr)
+Image::SetPrefetcher로 등록하면 Image::Load가 먼저 여기서 찾음
+*/
+CLASS_PTR(ImagePrefetcher)
+class ImagePrefetcher {
+public:
+    struct Request {
+        std::string filepath;
+        bool flipVertical { true };
+    };
+
+    // threadCount가 0이면 코어 수 (요청 수보다 많이 만들지 않음)
+    static ImagePrefetcherUPtr Start(const std::vector<Request>& requests, int threadCount = 0);
+    // 남은 디코딩이 끝날 때까지 대기
+    ~ImagePrefetcher();
+
+    // 같은 이미지는 한 번만 넘겨줌, 두 번째부터는 nullptr
+    ImageUPtr Take(const std::string& filepath, bool flipVertical);
+
+private:
+    ImagePrefetcher() {}
+    void Run();
+
+    struct Entry {
+        Request request;
+        ImageUPtr image;
+        bool done { false };
+        bool taken { false };
+    };
+
+    std::vector<Entry> m_entries;
+    size_t m_next { 0 };
+    std::mutex m_mutex;
+    std::condition_variable m_doneCondition;
+    std::vector<std::thread> m_workers;
+};
+
+#endif // __IMAGE_PREFETCHER_H__
\ No newline at end of file
@@ -1,55 +1,77 @@
 #include "lsystem.h"
 
-LSystemUPtr LSystem::Create(std::string axiom, std::string rules, std::vector<float> treeParam, float angle, int iteration,
-        bool sphere, float xCoord, float zCoord) {
+namespace {
+
+// 쉐이더의 aRow0 ~ aRow2 (vertex attribute 0 ~ 3 다음)
+const uint32_t INSTANCE_LOCATION = 4;
+
+} // namespace
+
+LSystemUPtr LSystem::Create(std::string axiom, std::string rules, const std::vector<float>& treeParam, float angle, int iteration,
+        bool sphere, float xCoord, float zCoord, uint32_t seed) {
+    GenerationArenaPtr arena = GenerationArena::Create();
+    auto tree = Tree::Create(std::move(axiom), std::move(rules), treeParam, angle, iteration, sphere, xCoord, zCoord, seed,
+        nullptr, arena.get());
+    if(!tree)
+        return nullptr;
     auto lsystem = LSystemUPtr(new LSystem());
-    if(!lsystem->Init(axiom, rules, treeParam, angle, iteration, sphere, xCoord, zCoord))
+    lsystem->m_arena = std::move(arena);
+    if(!lsystem->Init(std::move(tree), nullptr, true))
         return nullptr;
-    
     return std::move(lsystem);
 }
 
-bool LSystem::Init(std::string axiom, std::string rules, std::vector<float> treeParam, float angle, int iteration,
-    bool sphere, float xCoord, float zCoord) {
-    if(treeParam.size() < 6) return false;
-    else if(treeParam[4] <= 0.0f && treeParam[5] <= 0.0f) return false;
-
-    m_codesVector.clear();
-    m_axiom = axiom;
-    m_rules = rules;
-    m_cylinderRadius = treeParam[0];
-    m_cylinderHeight = treeParam[1];
-    m_leafRadius = treeParam[2];
-    m_leafHeight = treeParam[3];
-    m_radiusScaling = treeParam[4];
-    m_heightScaling = treeParam[5];
-
-    m_angle = angle;
-    m_iteration = iteration;
-    m_isSphere = sphere;
+LSystemUPtr LSystem::CreateFromTree(TreeUPtr tree, const LSystem* shared, bool optimizeMeshes) {
+    auto lsystem = LSystemUPtr(new LSystem());
+    if(!lsystem->Init(std::move(tree), shared, optimizeMeshes))
+        return nullptr;
 
-    m_xCoord = xCoord;
-    m_zCoord = zCoord;
+    return std::move(lsystem);
+}
 
-    std::istringstream ss(rules);
-    std::string token;
-    while (std::getline(ss, token, '\n')) {
-        m_codesVector.push_back(token);
+// GL 리소스 생성 (렌더 스레드)
+bool LSystem::Init(TreeUPtr tree, const LSystem* shared, bool optimizeMeshes) {
+    m_tree = std::move(tree);
+    // Create에서 나무를 만든 arena를 이미 넣었으면 그대로 사용
+    if(!m_arena)
+        m_arena = shared ? shared->m_arena : GenerationArena::Create();
+
+    // 나무/잎 쉐이더는 position, texCoord만 사용하므로 압축 형식으로 충분
+    // export는 Tree의 mesh 데이터를 사용하므로 CPU 사본은 필요 없음
+    MeshOptions meshOptions;
+    meshOptions.format = VertexFormat::Packed;
+    meshOptions.retention = CpuRetention::None;
+    meshOptions.optimize = optimizeMeshes;
+    auto& logMesh = m_tree->GetLogMesh();
+    auto& leafMesh = m_tree->GetLeafMesh();
+    auto& sphereMesh = m_tree->GetSphereMesh();
+    m_log = Mesh::Create(logMesh.vertices, logMesh.indices, GL_TRIANGLES, meshOptions);
+    m_leaf = Mesh::Create(leafMesh.vertices, leafMesh.indices, GL_TRIANGLES, meshOptions);
+    m_sphere = Mesh::Create(sphereMesh.vertices, sphereMesh.indices, GL_TRIANGLES, meshOptions);
+
+    // 파일에서 불러온 나무는 매핑된 배열을 복사 없이 그대로 업로드
+    m_cylinderInstances = UploadInstances(m_tree->GetCylinderTransforms());
+    m_leafInstances = UploadInstances(m_tree->GetLeafTransforms());
+    if(m_cylinderInstances.buffer)
+        m_log->SetInstanceBuffer(m_cylinderInstances.buffer, INSTANCE_LOCATION, 3, m_cylinderInstances.type);
+    if(m_leafInstances.buffer) {
+        m_leaf->SetInstanceBuffer(m_leafInstances.buffer, INSTANCE_LOCATION, 3, m_leafInstances.type);
+        m_sphere->SetInstanceBuffer(m_leafInstances.buffer, INSTANCE_LOCATION, 3, m_leafInstances.type);
+    }
+
+    if(shared) {
+        m_leafTexture = shared->m_leafTexture;
+        m_greenTexture = shared->m_greenTexture;
+        m_treeImage = shared->m_treeImage;
+        m_treeTexture = shared->m_treeTexture;
+        m_logProgram = shared->m_logProgram;
+        m_leafProgram = shared->m_leafProgram;
+        return true;
     }
 
-    m_codes = MakeCodes();
-    // m_cylinderHeight *= 1.2f;
-    // m_cylinderRadius *= 1.3f;
-    MakeCylinderMatrices(m_xCoord, m_zCoord);
-
-    m_log = Mesh::CreateCylinder(m_cylinderRadius, m_cylinderHeight, m_radiusScaling);
-    m_leaf = Mesh::CreateLeaf(m_leafRadius, m_leafHeight);
-    m_sphere = Mesh::CreateSphere(m_leafRadius);
-
-    m_leafTexture = Texture::CreateFromImage(Image::Load("./image/leaf2.png").get());
+    m_leafTexture = Texture::Load("./image/leaf2.png");
     m_greenTexture = Texture::CreateFromImage(Image::CreateSingleColorImage(4, 4, glm::vec4(0.27f, 0.334f, 0.118f, 1.0f)).get());
-    m_treeImage = Image::Load("./image/tree.png");
-    m_treeTexture = Texture::CreateFromImage(m_treeImage.get());
+    m_treeTexture = Texture::Load("./image/tree.png");
 
     m_logProgram = Program::Create("./shader/cylinder.vs", "./shader/cylinder.fs");
     if(!m_logProgram) return false;
@@ -60,462 +82,74 @@ bool LSystem::Init(std::string axiom, std::string rules, std::vector<float> tree
     return true;
 }
 
-std::string LSystem::MakeCodes() {
-    std::random_device rd; // 시드로 사용할 장치
-    std::mt19937 gen(rd()); // 난수 엔진
-
-    std::string tmp;
-
-    std::vector<std::string> F;
-    std::vector<std::string> X;
-    std::vector<std::string> A;
-    std::vector<std::string> C;
-
-    bool FCheck = false;
-    bool XCheck = false;
-    bool ACheck = false;
-    bool CCheck = false;
-    
-    // 각 벡터에 변환 규칙을 삽입
-    for(int i=0; i<m_codesVector.size(); i++) {
-        tmp = m_codesVector[i];
-        std::size_t pos = tmp.rfind('=');
-        if(pos == std::string::npos) continue;
-
-        std::string condition = tmp.substr(0, pos);
-        std::string replace = tmp.substr(pos + 1);
-
-        if(condition.compare("F") == 0)
-            F.push_back(replace);
-        else if(condition.compare("X") == 0)
-            X.push_back(replace);
-        else if(condition.compare("A") == 0)
-            A.push_back(replace);
-        else if(condition.compare("C") == 0)
-            C.push_back(replace);
+LSystem::Instances LSystem::UploadInstances(const TreeTransforms& transforms) {
+    Instances instances;
+    instances.count = transforms.count;
+    instances.type = transforms.quantized ? GL_UNSIGNED_SHORT : GL_FLOAT;
+    for(int r = 0; r < 3; r++) {
+        instances.rowMinimum[r] = transforms.quantized ? glm::make_vec4(transforms.minimum + r * 4) : glm::vec4(0.0f);
+        instances.rowScale[r] = transforms.quantized ? glm::make_vec4(transforms.scale + r * 4) : glm::vec4(1.0f);
     }
-
-    std::string result = m_axiom; // 치환될 문자열
-    std::string new_str; // 규칙 문자열
-
-    auto StringCheck = [] (char replace, std::string str) -> bool {
-        if(str.find(replace) == std::string::npos) return false;
-        return true;
-    };
-
-    auto ReplaceString = [&result, &new_str, &gen] (char replace, std::vector<std::string> vector, bool check) {
-        size_t pos = 0;
-        while ((pos = result.find(replace, pos)) != std::string::npos) {
-            if(vector.empty() || !check) break;
-            else if(vector.size() == 1) {
-                new_str = vector[0];
-            }
-            else {
-                std::uniform_int_distribution<> dis(0, vector.size() - 1); // 범위 설정
-                int randomIndex = dis(gen);
-                new_str = vector[randomIndex];
-            }
-            result.replace(pos, 1, new_str);
-            pos += new_str.length();
-        }
-    };
-
-    for(int i = 0; i < m_iteration; i++) {
-        FCheck = StringCheck('F', result);
-        XCheck = StringCheck('X', result);
-        ACheck = StringCheck('A', result);
-        CCheck = StringCheck('C', result);
-
-        ReplaceString('F', F, FCheck);
-        ReplaceString('X', X, XCheck);
-        ReplaceString('A', A, ACheck);
-        ReplaceString('C', C, CCheck);
+    if(transforms.count > 0) {
+        instances.buffer = Buffer::CreateWithData(GL_ARRAY_BUFFER, GL_STATIC_DRAW, transforms.data,
+            transforms.size / transforms.count, transforms.count);
     }
-
-    return result;
-}
-
-void LSystem::MakeLeafMatrices(glm::mat4 matrices, glm::mat4 scaling, std::vector<glm::mat4>& vector) {
-    auto translate = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, m_cylinderHeight / -2.0f, 0.0f));
-    vector.push_back(matrices * translate * scaling);
+    return instances;
 }
 
-// 회전 후 이동 -> 이동행렬 * 회전행렬 (순서)
-void LSystem::MakeCylinderMatrices(float xCoord, float zCoord) {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::normal_distribution<float> normalDistFrontGen(0.0f, 2.0f);
-    std::normal_distribution<float> normalDistEndGen(0.0f, 0.5f);
-    std::normal_distribution<float> normalDistAngle(m_angle, 4.0f);
-    std::uniform_real_distribution<float> uniformDist(m_heightScaling - 0.05f, m_heightScaling + 0.05f);
-
-    // 나뭇가지를 생성하는 위치를 결정하는 코드
-    MatrixStack stack(xCoord, zCoord); // 행렬 연산을 위한 스택
-    std::stack<int> stackCount; // pop 하는 수를 정하기 위한 스택
-
-    MatrixStack scalingStack; // 나뭇잎 크기 계산을 위함
-    std::stack<int> scalingCount;
-
-    // stack.pushMatrix(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, m_cylinderHeight/1.7f, 0.0f)));
-    stackCount.push(0);
-    scalingCount.push(0);
-
-    int randomNum;
-    float weight = 1.5f;
-    std::vector<glm::mat4> modelMatrices;
-    std::vector<glm::mat4> leafMatrices;
-
-    int matrixTop = 0;
-    int directionTop = 0;
-    int scalingTop = 0;
-    auto matrixFunction = [&]()-> void {
-        matrixTop = stackCount.top();
-        matrixTop+=1;
-        stackCount.pop();
-        stackCount.push(matrixTop);
-    };
-
-    float randomAngle = 0.0f;
-    glm::mat4 scalingInverse;
-
-    auto coord = glm::translate(glm::mat4(1.0f), glm::vec3(5.0f, 0.0f, 3.0f));
-    for(int i=0; i<m_codes.length(); i++){
-        randomAngle = normalDistAngle(gen);
-        switch(m_codes.at(i)){
-        case 'F': case 'X': case 'A': case 'C':
-            matrixFunction();
-            stack.pushMatrix(glm::scale(glm::mat4(1.0f), glm::vec3(m_radiusScaling, m_heightScaling, m_radiusScaling)) *
-                glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, m_cylinderHeight * (m_heightScaling + 1.0f) / 2.2f, 0.0f))); // 방향
-            modelMatrices.push_back(stack.getCurrentMatrix());
-
-            scalingTop = scalingCount.top();
-            scalingTop+=1;
-            scalingCount.pop();
-            scalingCount.push(scalingTop);
-            // 역행렬이 무조건 존재한다고 가정
-            scalingInverse = glm::scale(glm::mat4(1.0f), glm::vec3(1.0f / m_radiusScaling,
-                1.0f / m_heightScaling, 1.0f / m_radiusScaling));
-            scalingStack.pushMatrix(scalingInverse);
-
-            // randomNum = static_cast<int>(floor((normalDistFrontGen(gen))));
-            // if(randomNum == 0 && !stack.isEmpty() && !scalingStack.isEmpty())
-            //     MakeLeafMatrices(stack.getCurrentMatrix(), scalingStack.getCurrentMatrix(), leafMatrices);
-            break;
-
-        case '+':
-            matrixFunction();
-            stack.pushMatrix(glm::rotate(glm::mat4(1.0f), glm::radians(randomAngle), glm::vec3(0.0f, 1.0f, 0.0f))); // 방향
-            break;
-
-        case '-':
-            matrixFunction();
-            stack.pushMatrix(glm::rotate(glm::mat4(1.0f), glm::radians(-1.0f * randomAngle), glm::vec3(0.0f, 1.0f, 0.0f))); // 방향
-            break;
-
-        case '^':
-            matrixFunction();
-            stack.pushMatrix(glm::rotate(glm::mat4(1.0f), glm::radians(randomAngle), glm::vec3(1.0f, 0.0f, 0.0f)) *
-                glm::translate(glm::mat4(1.0f), glm::vec3(
-                    0.0f, 0.0f, weight * sin(randomAngle * M_PI / 180.0f) * (m_cylinderHeight/2.0f)))); // 방향
-            break;
-
-        case '&':
-            matrixFunction();
-            stack.pushMatrix(glm::rotate(glm::mat4(1.0f), glm::radians(-1.0f * randomAngle), glm::vec3(1.0f, 0.0f, 0.0f)) * 
-                glm::translate(glm::mat4(1.0f),glm::vec3(
-                0.0f, 0.0f,-1.0 * weight *sin(randomAngle * M_PI / 180.0f) * (m_cylinderHeight/2.0f)))); // 방향
-            break;
-
-        case '<':
-            matrixFunction();
-            stack.pushMatrix(glm::rotate(glm::mat4(1.0f), glm::radians(randomAngle), glm::vec3(0.0f, 0.0f, 1.0f)) *
-                glm::translate(glm::mat4(1.0f), glm::vec3(
-                -1.0 * weight * sin(randomAngle * M_PI / 180.0f) * (m_cylinderHeight/2.0f), 0.0f, 0.0f))); // 방향
-            break;
-
-        case '>':
-            matrixFunction();
-            stack.pushMatrix(glm::rotate(glm::mat4(1.0f), glm::radians(-1.0f * randomAngle), glm::vec3(0.0f, 0.0f, 1.0f)) * 
-                glm::translate(glm::mat4(1.0f), glm::vec3(
-                weight * sin(randomAngle * M_PI / 180.0f) * (m_cylinderHeight/2.0f), 0.0f, 0.0f))); // 방향
-            break;
-
-        case '|':
-            matrixFunction();
-            stack.pushMatrix(glm::rotate(glm::mat4(1.0f), glm::radians(180.0f), glm::vec3(0.0f, 1.0f, 0.0f))); // 방향
-            break;
-
-        case '[':
-            stackCount.push(0);
-            scalingCount.push(0);
-            break;
-
-        case ']':
-            randomNum = static_cast<int>(floor((normalDistEndGen(gen))));
-            if((m_codes.at(i-1) == 'X' || m_codes.at(i-1) == 'F' || m_codes.at(i-1) == 'A' || m_codes.at(i-1) == 'C')
-                && randomNum == 0 || randomNum == -1) {
-                MakeLeafMatrices(stack.getCurrentMatrix(), scalingStack.getCurrentMatrix(), leafMatrices);
-            }
-                
-            for(int i=0; i<stackCount.top(); i++)
-                stack.popMatrix();
-            for(int i=0; i<scalingCount.top(); i++)
-                scalingStack.popMatrix();
-
-            stackCount.pop();
-            scalingCount.pop();
-            break;
-        }
-    }
-    m_cylinderVector.clear();
-    m_leafVector.clear();
-    m_cylinderVector = modelMatrices;
-    m_leafVector = leafMatrices;
+void LSystem::SetInstanceRange(const Program* program, const Instances& instances) {
+    program->SetUniform("rowMinimum", Span<const glm::vec4>(instances.rowMinimum, 3));
+    program->SetUniform("rowScale", Span<const glm::vec4>(instances.rowScale, 3));
 }
 
 void LSystem::Draw(const glm::mat4& projection, const glm::mat4& view) const {
-    if(!m_codes.empty()) {
+    if(!m_tree->isEmpty()) {
+        // transform은 나무의 local 좌표, 배치 위치는 그릴 때 한 번만 곱함 (Move는 다시 해석하지 않음)
+        auto treeTransform = projection * view * m_tree->GetPlacement();
         m_logProgram->Use();
         m_logProgram->SetUniform("tex", 0);
-        // m_brownTexture->Bind();
         m_treeTexture->Bind();
-
-        for(int i=0; i<m_cylinderVector.size(); i++) {
-            auto transform = projection * view * m_cylinderVector[i] * glm::translate(glm::mat4(1.0f),
-                glm::vec3(0.0f, -1.0f * m_cylinderHeight, 0.0f));
-            m_logProgram->SetUniform("transform", transform);
-            // m_logProgram->SetUniform("color", glm::vec3(0.6f, 0.4f, 0.2f));
-            // treeProgram->SetUniform("modelTransform", m_modelMatrices[i]);
-            m_log->Draw(m_logProgram.get());
-        }
+        m_logProgram->SetUniform("transform", treeTransform);
+        m_logProgram->SetUniform("localTransform", glm::translate(glm::mat4(1.0f),
+            glm::vec3(0.0f, -1.0f * m_tree->GetCylinderHeight(), 0.0f)) * m_log->GetPositionTransform());
+        SetInstanceRange(m_logProgram.get(), m_cylinderInstances);
+        m_log->DrawInstanced(m_logProgram.get(), m_cylinderInstances.count);
 
         m_leafProgram->Use();
         m_leafProgram->SetUniform("tex", 0);
-        if(m_isSphere) {
+        m_leafProgram->SetUniform("transform", treeTransform);
+        SetInstanceRange(m_leafProgram.get(), m_leafInstances);
+        if(m_tree->IsSphere()) {
             m_greenTexture->Bind();
-            for(int i=0; i<m_leafVector.size(); i++){
-                m_leafProgram->SetUniform("transform", projection * view * m_leafVector[i]);
-                m_sphere->Draw(m_leafProgram.get());
-            }
+            m_leafProgram->SetUniform("localTransform", m_sphere->GetPositionTransform());
+            m_sphere->DrawInstanced(m_leafProgram.get(), m_leafInstances.count);
         }
         else {
             m_treeTexture->Bind();
-            for(int i=0; i<m_leafVector.size(); i++){
-                m_leafProgram->SetUniform("transform", projection * view * m_leafVector[i]);
-                m_leaf->Draw(m_leafProgram.get());
-            }
+            m_leafProgram->SetUniform("localTransform", m_leaf->GetPositionTransform());
+            m_leaf->DrawInstanced(m_leafProgram.get(), m_leafInstances.count);
         }
     }
 }
 
 void LSystem::Move(float xCoord, float zCoord) {
-    if(xCoord == m_xCoord && zCoord == m_zCoord) return;
-
-    m_xCoord = xCoord;
-    m_zCoord = zCoord;
-    MakeCylinderMatrices(xCoord, zCoord);
+    m_tree->Move(xCoord, zCoord);
 }
 
-bool LSystem::ExportObj(std::ofstream& out, std::string material) {
-    if (!out.is_open()) {
-        SPDLOG_ERROR("Failed to open file : {}", std::to_string(out.tellp()));
-        return false;
-    }
-
-    int stride = m_log->GetVertexBuffer()->GetCount();
-    std::vector<Vertex> modelVertex = m_log->GetVertexVector();
-    std::vector<int> modelIndex = m_log->GetIndexVector();
-
-    std::vector<std::tuple<float, float, float>> v;
-    std::vector<std::tuple<float, float>> vt;
-    std::vector<std::tuple<float, float, float>> vn;
-    std::vector<std::tuple<int, int, int>> f;
-
-    for(int i=0; i<m_cylinderVector.size(); i++) {
-        int start = stride * i;
-        // vertex positions
-        auto matrix = m_cylinderVector[i] * glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, -1.0f * m_cylinderHeight, 0.0f));
-        for (const auto& vertex : modelVertex) {
-            auto vertexAffine = glm::vec4(vertex.position.x, vertex.position.y, vertex.position.z, 1);
-            auto normalAffine = glm::vec4(vertex.normal.x, vertex.normal.y, vertex.normal.z, 0);
-            vertexAffine = matrix * vertexAffine;
-            normalAffine = matrix * normalAffine;
-
-            v.push_back(std::tuple<float, float, float>(vertexAffine.x, vertexAffine.y, vertexAffine.z));
-            vt.push_back(std::tuple<float, float>(vertex.texCoord.x, vertex.texCoord.y));
-            vn.push_back(std::tuple<float, float, float>(normalAffine.x, normalAffine.y, normalAffine.z));
-        }
-
-        // faces using indices
-        size_t indexCount = modelIndex.size();
-        for (size_t j = 0; j < indexCount; j += 3) {
-            uint32_t index1 = modelIndex[j] + start + 1;
-            uint32_t index2 = modelIndex[j+1] + start + 1;
-            uint32_t index3 = modelIndex[j+2] + start + 1;
-
-            f.push_back(std::tuple<int, int, int>(index1, index2, index3));
-        }
-    }
-
-    out << "# tree generator\n\n";
-    out << "# material\n";
-    out << "mtllib ./" + material + ".mtl\n";
-
-    out << "o Cylinder\n";
-    out << "# vertex coordinates\n";
-    for(int i=0; i<v.size(); i++) {
-        out << "v " << std::get<0>(v[i]) << " " << std::get<1>(v[i]) << " " << std::get<2>(v[i]) << "\n";
-    }
-
-    out << "\n# texture coordinates\n";
-    for(int i=0; i<vt.size(); i++) {
-        out << "vt " << std::get<0>(vt[i]) << " " << std::get<1>(vt[i]) << "\n";
-    }
-
-    out << "\n# normal coordinates\n";
-    for(int i=0; i<vn.size(); i++) {
-        out << "vn " << std::get<0>(vn[i]) << " " << std::get<1>(vn[i]) << " " << std::get<2>(vn[i]) << "\n";
-    }
-
-    out << "\n# face\n";
-    out << "usemtl Tree\n";
-    for(int i=0; i<f.size(); i++) {
-        out << "f "
-                << std::get<0>(f[i]) << "/" << std::get<0>(f[i]) << "/" << std::get<0>(f[i]) << " "
-                << std::get<1>(f[i]) << "/" << std::get<1>(f[i]) << "/" << std::get<1>(f[i]) << " "
-                << std::get<2>(f[i]) << "/" << std::get<2>(f[i]) << "/" << std::get<2>(f[i])
-                << "\n";
-    }
-
-    v.clear();
-    vt.clear();
-    vn.clear();
-    f.clear();
-
-    if(m_isSphere) {
-        std::vector<Vertex> sphereVertex = m_sphere->GetVertexVector();
-        std::vector<int> sphereIndex = m_sphere->GetIndexVector();
-        int sphereStart = stride * m_cylinderVector.size();
-
-        int sphereStride = m_sphere->GetVertexBuffer()->GetCount();
-        for(int i = 0; i < m_leafVector.size(); i++) {
-            int start = sphereStride * i;
-            // vertex positions
-            auto matrix = m_leafVector[i];
-            for (const auto& vertex : sphereVertex) {
-                auto vertexAffine = glm::vec4(vertex.position.x, vertex.position.y, vertex.position.z, 1);
-                auto normalAffine = glm::vec4(vertex.normal.x, vertex.normal.y, vertex.normal.z, 0);
-                vertexAffine = matrix * vertexAffine;
-                normalAffine = matrix * normalAffine;
-
-                v.push_back(std::tuple<float, float, float>(vertexAffine.x, vertexAffine.y, vertexAffine.z));
-                vt.push_back(std::tuple<float, float>(vertex.texCoord.x, vertex.texCoord.y));
-                vn.push_back(std::tuple<float, float, float>(normalAffine.x, normalAffine.y, normalAffine.z));
-            }
-
-            // faces using indices
-            size_t indexCount = sphereIndex.size();
-            for (size_t j = 0; j < indexCount; j += 3) {
-                uint32_t index1 = sphereIndex[j] + sphereStart + start + 1;
-                uint32_t index2 = sphereIndex[j+1] + sphereStart + start + 1;
-                uint32_t index3 = sphereIndex[j+2] + sphereStart + start + 1;
-
-                f.push_back(std::tuple<int, int, int>(index1, index2, index3));
-            }
-        }
-    }
-    else {
-        std::vector<Vertex> leafVertex = m_leaf->GetVertexVector();
-        std::vector<int> leafIndex = m_leaf->GetIndexVector();
-        int leafStart = stride * m_cylinderVector.size();
-        
-        int leafStride = m_leaf->GetVertexBuffer()->GetCount();
-        for(int i = 0; i<m_leafVector.size(); i++) {
-            int start = leafStride * i;
-            // vertex positions
-            auto matrix = m_leafVector[i];
-            for (const auto& vertex : leafVertex) {
-                auto vertexAffine = glm::vec4(vertex.position.x, vertex.position.y, vertex.position.z, 1);
-                auto normalAffine = glm::vec4(vertex.normal.x, vertex.normal.y, vertex.normal.z, 0);
-                vertexAffine = matrix * vertexAffine;
-                normalAffine = matrix * normalAffine;
-
-                v.push_back(std::tuple<float, float, float>(vertexAffine.x, vertexAffine.y, vertexAffine.z));
-                vt.push_back(std::tuple<float, float>(vertex.texCoord.x, vertex.texCoord.y));
-                vn.push_back(std::tuple<float, float, float>(normalAffine.x, normalAffine.y, normalAffine.z));
-            }
-
-            // faces using indices
-            size_t indexCount = leafIndex.size();
-            for (size_t j = 0; j < indexCount; j += 3) {
-                uint32_t index1 = leafIndex[j] + leafStart + start + 1;
-                uint32_t index2 = leafIndex[j+1] + leafStart + start + 1;
-                uint32_t index3 = leafIndex[j+2] + leafStart + start + 1;
-
-                f.push_back(std::tuple<int, int, int>(index1, index2, index3));
-            }
-        }
-    }
-
-    out << "\no Leaf\n";
-    out << "# vertex coordinates\n";
-    for(int i=0; i<v.size(); i++) {
-        out << "v " << std::get<0>(v[i]) << " " << std::get<1>(v[i]) << " " << std::get<2>(v[i]) << "\n";
-    }
-
-    out << "\n# texture coordinates\n";
-    for(int i=0; i<vt.size(); i++) {
-        out << "vt " << std::get<0>(vt[i]) << " " << std::get<1>(vt[i]) << "\n";
-    }
-
-    out << "\n# normal coordinates\n";
-    for(int i=0; i<vn.size(); i++) {
-        out << "vn " << std::get<0>(vn[i]) << " " << std::get<1>(vn[i]) << " " << std::get<2>(vn[i]) << "\n";
-    }
-
-    out << "\n# face\n";
-    out << "usemtl Tree\n";
-    for(int i=0; i<f.size(); i++) {
-        out << "f "
-                << std::get<0>(f[i]) << "/" << std::get<0>(f[i]) << "/" << std::get<0>(f[i]) << " "
-                << std::get<1>(f[i]) << "/" << std::get<1>(f[i]) << "/" << std::get<1>(f[i]) << " "
-                << std::get<2>(f[i]) << "/" << std::get<2>(f[i]) << "/" << std::get<2>(f[i])
-                << "\n";
-    }
-
-    return true;
+bool LSystem::ExportObj(std::ofstream& out, const std::string& material) {
+    return m_tree->ExportObj(out, material);
 }
 
-bool LSystem::ExportMtl(std::ofstream& out, std::string texture) {
-    if (!out.is_open()) {
-        SPDLOG_ERROR("Failed to open file : {}", std::to_string(out.tellp()));
-        return false;
-    }
-
-    out << "# Dice.mtl\n\n";
-
-    out << "newmtl Tree\n\n";
-
-    out << "# ambient color\n";
-    out << "Ka 0.2 0.2 0.2\n\n";
-
-    out << "# diffuse color\n";
-    out << "Kd 0.7 0.7 0.7\n\n";
-
-    out << "# specular color\n";
-    out << "Ka 0.7 0.7 0.7\n\n";
-
-    out << "# Blinn-Phong shading\n";
-    out << "illum 2\n\n";
-
-    out << "# texture\n";
-    // out << "map_Kd ./" + texture + ".png\n";
-    out << "map_Kd ./tree.png\n";
-
-    return true;
+bool LSystem::ExportMtl(std::ofstream& out, const std::string& texture) {
+    return m_tree->ExportMtl(out, texture);
 }
 
 bool LSystem::ExportTexture(const char* imageOutputPath) {
+    // 텍스쳐는 변환 파일에서 바로 올리므로 이미지는 export할 때만 디코딩
+    if (!m_treeImage)
+        m_treeImage = Image::Load("./image/tree.png");
+    if (!m_treeImage)
+        return false;
     m_treeImage->SaveImage(imageOutputPath);
     return true;
 }
\ No newline at end of file
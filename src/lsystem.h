@@ -2,10 +2,10 @@
 #define __LSYSTEM_H__
 
 #include "common.h"
-#include "matrix_stack.h"
 #include "program.h"
 #include "mesh.h"
 #include "texture.h"
+#include "tree.h"
 #include <regex>
 #define _USE_MATH_DEFINES
 #include <math.h>
@@ -16,64 +16,62 @@
 #include <fstream>
 
 
-// "이동"에 사용되는 문자 : F, X, A, C
+// 화면에 그리는 부분 (GL), 나무 생성은 Tree
+// 가지 / 잎은 Tree의 transform 배열을 그대로 instance buffer에 올려서 한 번에 그림
 CLASS_PTR(LSystem);
 class LSystem {
 public:
     // std::vector {cylinderRadius, cylinderHeight, leafRadius, leafHeight, radiusScaling, heightScaling}
-    static LSystemUPtr Create(std::string axiom, std::string rules, std::vector<float> treeParam, float angle, int iteration,
-        bool sphere = false, float xCoord = 0.0f, float zCoord = 0.0f);
-    std::string GetAxiom() { return m_axiom; }
-    std::string GetRules() { return m_rules; }
-    std::string GetCodes() { return m_codes; }
-    bool isEmpty() { return m_codes.empty(); }
+    static LSystemUPtr Create(std::string axiom, std::string rules, const std::vector<float>& treeParam, float angle, int iteration,
+        bool sphere = false, float xCoord = 0.0f, float zCoord = 0.0f, uint32_t seed = Tree::RANDOM_SEED);
+    // 다른 스레드에서 만든 Tree (또는 Tree::CreateFromFile)로 GL 리소스만 생성
+    // shared가 있으면 텍스쳐와 쉐이더는 새로 만들지 않고 같이 사용 (mesh만 생성)
+    // optimizeMeshes : 가지 / 잎 mesh에 MeshOptions::optimize 적용
+    static LSystemUPtr CreateFromTree(TreeUPtr tree, const LSystem* shared = nullptr, bool optimizeMeshes = true);
+    const std::string& GetAxiom() const { return m_tree->GetAxiom(); }
+    const std::string& GetRules() const { return m_tree->GetRules(); }
+    const std::string& GetCodes() const { return m_tree->GetCodes(); }
+    bool isEmpty() { return m_tree->isEmpty(); }
+    const Tree* GetTree() const { return m_tree.get(); }
+    // 이 나무를 다시 생성할 때 쓰는 arena (CreateFromTree의 shared와 같이 사용)
+    GenerationArenaPtr GetArena() const { return m_arena; }
     void Draw(const glm::mat4& projection, const glm::mat4& view) const;
     void Move(float xCoord, float zCoord);
-    bool ExportObj(std::ofstream& out, std::string material);
-    bool ExportMtl(std::ofstream& out, std::string texture);
+    bool ExportObj(std::ofstream& out, const std::string& material);
+    bool ExportMtl(std::ofstream& out, const std::string& texture);
     bool ExportTexture(const char* imageOutputPath);
 
 private:
     LSystem() {};
-    bool Init(std::string axiom, std::string rules, std::vector<float> treeParam, float angle, int iteration,
-        bool sphere, float zCoord, float xCoord);
-    std::string MakeCodes();
-    void MakeCylinderMatrices(float xCoord = 0.0f, float zCoord = 0.0f);
-    void MakeLeafMatrices(glm::mat4 matrices, glm::mat4 scaling, std::vector<glm::mat4>& vector);
+    bool Init(TreeUPtr tree, const LSystem* shared, bool optimizeMeshes);
 
-    ProgramUPtr m_logProgram;
-    ProgramUPtr m_leafProgram;
+    // instance buffer와 쉐이더에서 복원할 범위 (양자화하지 않았으면 minimum 0, scale 1)
+    struct Instances {
+        size_t count { 0 };
+        uint32_t type { GL_FLOAT };
+        BufferPtr buffer;
+        glm::vec4 rowMinimum[3];
+        glm::vec4 rowScale[3];
+    };
+    static Instances UploadInstances(const TreeTransforms& transforms);
+    static void SetInstanceRange(const Program* program, const Instances& instances);
+
+    TreeUPtr m_tree;
+    GenerationArenaPtr m_arena;
+
+    ProgramPtr m_logProgram;
+    ProgramPtr m_leafProgram;
 
     MeshUPtr m_log;
     MeshUPtr m_leaf;
     MeshUPtr m_sphere;
+    Instances m_cylinderInstances;
+    Instances m_leafInstances;
 
-    ImageUPtr m_treeImage;
+    ImagePtr m_treeImage;
     TexturePtr m_leafTexture;
     TexturePtr m_greenTexture;
     TexturePtr m_treeTexture;
-
-    std::vector<glm::mat4> m_cylinderVector;
-    std::vector<glm::mat4> m_leafVector;
-    std::string m_axiom;
-    std::string m_rules;
-
-    float m_cylinderRadius;
-    float m_cylinderHeight;
-    float m_leafRadius;
-    float m_leafHeight;
-    float m_radiusScaling;
-    float m_heightScaling;
-
-    float m_angle;
-    int m_iteration;
-    bool m_isSphere;
-
-    float m_xCoord;
-    float m_zCoord;
-
-    std::vector<std::string> m_codesVector;
-    std::string m_codes;
 };
 
 #endif //__LSYSTEM_H__
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFileUPtr MappedFile::Open(const std::string& filename) {
+    auto file = MappedFileUPtr(new MappedFile());
+    if (!file->Map(filename))
+        return nullptr;
+    return std::move(file);
+}
+
+#ifdef _WIN32
+bool MappedFile::Map(const std::string& filename) {
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ,
+        nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        SPDLOG_ERROR("failed to open file: {}", filename);
+        return false;
+    }
+    m_file = file;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        SPDLOG_ERROR("failed to get file size: {}", filename);
+        return false;
+    }
+    m_size = (size_t)size.QuadPart;
+    // 빈 파일은 매핑할 수 없으므로 데이터 없이 성공 처리
+    if (m_size == 0)
+        return true;
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        SPDLOG_ERROR("failed to map file: {}", filename);
+        return false;
+    }
+    m_mapping = mapping;
+
+    m_data = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!m_data) {
+        SPDLOG_ERROR("failed to map view of file: {}", filename);
+        return false;
+    }
+    return true;
+}
+
+MappedFile::~MappedFile() {
+    if (m_data)
+        UnmapViewOfFile(m_data);
+    if (m_mapping)
+        CloseHandle((HANDLE)m_mapping);
+    if (m_file)
+        CloseHandle((HANDLE)m_file);
+}
+#else
+bool MappedFile::Map(const std::string& filename) {
+    m_fd = open(filename.c_str(), O_RDONLY);
+    if (m_fd < 0) {
+        SPDLOG_ERROR("failed to open file: {}", filename);
+        return false;
+    }
+
+    struct stat status;
+    if (fstat(m_fd, &status) != 0) {
+        SPDLOG_ERROR("failed to get file size: {}", filename);
+        return false;
+    }
+    m_size = (size_t)status.st_size;
+    if (m_size == 0)
+        return true;
+
+    void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+    if (data == MAP_FAILED) {
+        SPDLOG_ERROR("failed to map file: {}", filename);
+        return false;
+    }
+    madvise(data, m_size, MADV_SEQUENTIAL);
+    m_data = (const char*)data;
+    return true;
+}
+
+MappedFile::~MappedFile() {
+    if (m_data)
+        munmap((void*)m_data, m_size);
+    if (m_fd >= 0)
+        close(m_fd);
+}
+#endif
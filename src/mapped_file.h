@@ -0,0 +1,30 @@
+#ifndef __MAPPED_FILE_H__
+#define __MAPPED_FILE_H__
+
+#include "core_common.h"
+
+// 파일 전체를 읽기 전용으로 메모리에 매핑 (복사 없이 바로 파싱하기 위함)
+CLASS_PTR(MappedFile)
+class MappedFile {
+public:
+    static MappedFileUPtr Open(const std::string& filename);
+    ~MappedFile();
+
+    const char* GetData() const { return m_data; }
+    size_t GetSize() const { return m_size; }
+
+private:
+    MappedFile() {}
+    bool Map(const std::string& filename);
+
+    const char* m_data { nullptr };
+    size_t m_size { 0 };
+#ifdef _WIN32
+    void* m_file { nullptr };
+    void* m_mapping { nullptr };
+#else
+    int m_fd { -1 };
+#endif
+};
+
+#endif // __MAPPED_FILE_H__
@@ -1,250 +1,310 @@
 #include "mesh.h"
-#define _USE_MATH_DEFINES
+#include "mesh_optimizer.h"
+#include "geometry.h"
+#include "frame_profiler.h"
 #include <math.h>
+#include <algorithm>
+#include <glm/gtc/packing.hpp>
 
 MeshUPtr Mesh::Create(const std::vector<Vertex>& vertices,
-    const std::vector<uint32_t>& indices, uint32_t primitiveType) {
+    const std::vector<uint32_t>& indices, uint32_t primitiveType,
+    const MeshOptions& options) {
 
     auto mesh = MeshUPtr(new Mesh());
-    mesh->Init(vertices, indices, primitiveType);
+    mesh->Init(vertices, indices, primitiveType, options);
+    return std::move(mesh);
+}
+
+MeshUPtr Mesh::CreateEmpty(size_t vertexCount, size_t indexCount, uint32_t primitiveType) {
+    auto mesh = MeshUPtr(new Mesh());
+    // CPU 사본이 없으므로 필요할 때 GPU에서 읽어옴
+    mesh->m_retention = CpuRetention::ReadBack;
+    mesh->InitBuffers(nullptr, vertexCount, nullptr, indexCount, primitiveType);
     return std::move(mesh);
 }
 
 void Mesh::Init(const std::vector<Vertex>& vertices,
-    const std::vector<uint32_t>& indices, uint32_t primitiveType) {
+    const std::vector<uint32_t>& indices, uint32_t primitiveType,
+    const MeshOptions& options) {
+
+    // 최적화 / tangent 계산으로 바꿀 때만 복사, 아니면 받은 데이터를 그대로 업로드
+    bool optimize = primitiveType == GL_TRIANGLES && options.optimize;
+    bool computeTangents = primitiveType == GL_TRIANGLES && options.computeTangents &&
+        options.format == VertexFormat::Float;
+    bool modify = optimize || computeTangents;
+    std::vector<Vertex> meshVertices;
+    std::vector<uint32_t> meshIndices;
+    if (modify) {
+        meshVertices = vertices;
+        meshIndices = indices;
+        if (optimize)
+            Optimize(meshVertices, meshIndices);
+        if (computeTangents)
+            ComputeTangents(meshVertices, meshIndices);
+    }
+    const auto& uploadVertices = modify ? meshVertices : vertices;
+    const auto& uploadIndices = modify ? meshIndices : indices;
+
+    m_format = options.format;
+    if (m_format == VertexFormat::Packed) {
+        std::vector<PackedVertex> packedVertices;
+        m_positionTransform = PackVertices(uploadVertices, packedVertices, m_halfTexCoord);
+        InitBuffers(packedVertices.data(), packedVertices.size(), uploadIndices.data(), uploadIndices.size(), primitiveType);
+    }
+    else {
+        InitBuffers(uploadVertices.data(), uploadVertices.size(), uploadIndices.data(), uploadIndices.size(), primitiveType);
+    }
 
-    if (primitiveType == GL_TRIANGLES) {
-        ComputeTangents(const_cast<std::vector<Vertex>&>(vertices), indices);
+    m_retention = options.retention;
+    if (m_retention == CpuRetention::Retained) {
+        if (modify) {
+            m_vertexVector = std::move(meshVertices);
+            m_indexVector = std::move(meshIndices);
+        }
+        else {
+            m_vertexVector = vertices;
+            m_indexVector = indices;
+        }
     }
+}
+
+Span<const Vertex> Mesh::GetVertices() {
+    if (m_retention == CpuRetention::ReadBack && m_vertexVector.empty())
+        ReadBack();
+    return m_vertexVector;
+}
+
+Span<const uint32_t> Mesh::GetIndices() {
+    if (m_retention == CpuRetention::ReadBack && m_indexVector.empty())
+        ReadBack();
+    return m_indexVector;
+}
+
+void Mesh::ReleaseCpuCopy() {
+    m_vertexVector = std::vector<Vertex>();
+    m_indexVector = std::vector<uint32_t>();
+    if (m_retention == CpuRetention::Retained)
+        m_retention = CpuRetention::ReadBack;
+}
+
+void Mesh::ReadBack() {
+    size_t vertexCount = m_vertexBuffer->GetCount();
+    if (m_format == VertexFormat::Packed) {
+        std::vector<PackedVertex> packedVertices(vertexCount);
+        m_vertexBuffer->GetSubData(0, packedVertices.data(), vertexCount * sizeof(PackedVertex));
+        UnpackVertices(packedVertices, m_positionTransform, m_halfTexCoord, m_vertexVector);
+    }
+    else {
+        m_vertexVector.resize(vertexCount);
+        m_vertexBuffer->GetSubData(0, m_vertexVector.data(), vertexCount * sizeof(Vertex));
+    }
+    m_indexVector.resize(m_indexBuffer->GetCount());
+    m_indexBuffer->GetSubData(0, m_indexVector.data(), m_indexVector.size() * sizeof(uint32_t));
+}
+
+void Mesh::Optimize(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+    if (indices.size() < 6)
+        return;
+
+    float before = ComputeACMR(indices, vertices.size());
+    OptimizeVertexCache(indices, vertices.size());
+    OptimizeOverdraw(indices, vertices);
+    OptimizeVertexFetch(vertices, indices);
+    float after = ComputeACMR(indices, vertices.size());
+
+    SPDLOG_DEBUG("optimize mesh: #vert: {}, #face: {}, ACMR: {:.3f} -> {:.3f}",
+        vertices.size(), indices.size() / 3, before, after);
+}
 
+void Mesh::InitBuffers(const void* vertices, size_t vertexCount,
+    const uint32_t* indices, size_t indexCount, uint32_t primitiveType) {
+
+    m_primitiveType = primitiveType;
     m_vertexLayout = VertexLayout::Create();
+    size_t vertexSize = m_format == VertexFormat::Packed ? sizeof(PackedVertex) : sizeof(Vertex);
     m_vertexBuffer = Buffer::CreateWithData(GL_ARRAY_BUFFER, GL_STATIC_DRAW,
-        vertices.data(), sizeof(Vertex), vertices.size());
+        vertices, vertexSize, vertexCount);
     m_indexBuffer = Buffer::CreateWithData(GL_ELEMENT_ARRAY_BUFFER, GL_STATIC_DRAW,
-        indices.data(), sizeof(uint32_t), indices.size());
+        indices, sizeof(uint32_t), indexCount);
+
+    if (m_format == VertexFormat::Packed) {
+        // 정수 attribute도 normalized로 지정하면 쉐이더에서는 그대로 vec3 / vec2로 읽힘
+        m_vertexLayout->SetAttrib(0, 3, GL_SHORT, true, sizeof(PackedVertex), offsetof(PackedVertex, position)); // position
+        m_vertexLayout->SetAttrib(1, 2, GL_SHORT, true, sizeof(PackedVertex), offsetof(PackedVertex, normal)); // octahedral normal
+        if (m_halfTexCoord)
+            m_vertexLayout->SetAttrib(2, 2, GL_HALF_FLOAT, false, sizeof(PackedVertex), offsetof(PackedVertex, texCoord)); // tex
+        else
+            m_vertexLayout->SetAttrib(2, 2, GL_UNSIGNED_SHORT, true, sizeof(PackedVertex), offsetof(PackedVertex, texCoord)); // tex
+        return;
+    }
     m_vertexLayout->SetAttrib(0, 3, GL_FLOAT, false, sizeof(Vertex), 0); // position
     m_vertexLayout->SetAttrib(1, 3, GL_FLOAT, false, sizeof(Vertex), offsetof(Vertex, normal)); // normal
     m_vertexLayout->SetAttrib(2, 2, GL_FLOAT, false, sizeof(Vertex), offsetof(Vertex, texCoord)); // tex
-    m_vertexLayout->SetAttrib(3, 3, GL_FLOAT, false, sizeof(Vertex), offsetof(Vertex, tangent)); // tex
-
-    m_vertexVector.assign(vertices.begin(), vertices.end());
-    m_indexVector.assign(indices.begin(), indices.end());
+    m_vertexLayout->SetAttrib(3, 3, GL_FLOAT, false, sizeof(Vertex), offsetof(Vertex, tangent)); // tangent
 }
 
-void Mesh::Draw(const Program* program) const {
-    m_vertexLayout->Bind();
-    if (m_material) {
-        m_material->SetToProgram(program);
-    }
-
-    glDrawElements(m_primitiveType, m_indexBuffer->GetCount(), GL_UNSIGNED_INT, 0);
-}
+glm::mat4 Mesh::PackVertices(const std::vector<Vertex>& vertices,
+    std::vector<PackedVertex>& packedVertices, bool& halfTexCoord) {
 
-MeshUPtr Mesh::CreateBox() {
-    std::vector<Vertex> vertices = {
-        Vertex { glm::vec3(-0.5f, -0.5f, -0.5f), glm::vec3( 0.0f,  0.0f, -1.0f), glm::vec2(0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f) },
-        Vertex { glm::vec3( 0.5f, -0.5f, -0.5f), glm::vec3( 0.0f,  0.0f, -1.0f), glm::vec2(1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f) },
-        Vertex { glm::vec3( 0.5f,  0.5f, -0.5f), glm::vec3( 0.0f,  0.0f, -1.0f), glm::vec2(1.0f, 1.0f), glm::vec3(0.0f, 0.0f, 0.0f) },
-        Vertex { glm::vec3(-0.5f,  0.5f, -0.5f), glm::vec3( 0.0f,  0.0f, -1.0f), glm::vec2(0.0f, 1.0f), glm::vec3(0.0f, 0.0f, 0.0f) },
-
-        Vertex { glm::vec3(-0.5f, -0.5f,  0.5f), glm::vec3( 0.0f,  0.0f,  1.0f), glm::vec2(0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f) },
-        Vertex { glm::vec3( 0.5f, -0.5f,  0.5f), glm::vec3( 0.0f,  0.0f,  1.0f), glm::vec2(1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f) },
-        Vertex { glm::vec3( 0.5f,  0.5f,  0.5f), glm::vec3( 0.0f,  0.0f,  1.0f), glm::vec2(1.0f, 1.0f), glm::vec3(0.0f, 0.0f, 0.0f) },
-        Vertex { glm::vec3(-0.5f,  0.5f,  0.5f), glm::vec3( 0.0f,  0.0f,  1.0f), glm::vec2(0.0f, 1.0f), glm::vec3(0.0f, 0.0f, 0.0f) },
-
-        Vertex { glm::vec3(-0.5f,  0.5f,  0.5f), glm::vec3(-1.0f,  0.0f,  0.0f), glm::vec2(1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f) },
-        Vertex { glm::vec3(-0.5f,  0.5f, -0.5f), glm::vec3(-1.0f,  0.0f,  0.0f), glm::vec2(1.0f, 1.0f), glm::vec3(0.0f, 0.0f, 0.0f) },
-        Vertex { glm::vec3(-0.5f, -0.5f, -0.5f), glm::vec3(-1.0f,  0.0f,  0.0f), glm::vec2(0.0f, 1.0f), glm::vec3(0.0f, 0.0f, 0.0f) },
-        Vertex { glm::vec3(-0.5f, -0.5f,  0.5f), glm::vec3(-1.0f,  0.0f,  0.0f), glm::vec2(0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f) },
-
-        Vertex { glm::vec3( 0.5f,  0.5f,  0.5f), glm::vec3( 1.0f,  0.0f,  0.0f), glm::vec2(1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f) },
-        Vertex { glm::vec3( 0.5f,  0.5f, -0.5f), glm::vec3( 1.0f,  0.0f,  0.0f), glm::vec2(1.0f, 1.0f), glm::vec3(0.0f, 0.0f, 0.0f) },
-        Vertex { glm::vec3( 0.5f, -0.5f, -0.5f), glm::vec3( 1.0f,  0.0f,  0.0f), glm::vec2(0.0f, 1.0f), glm::vec3(0.0f, 0.0f, 0.0f) },
-        Vertex { glm::vec3( 0.5f, -0.5f,  0.5f), glm::vec3( 1.0f,  0.0f,  0.0f), glm::vec2(0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f) },
-
-        Vertex { glm::vec3(-0.5f, -0.5f, -0.5f), glm::vec3( 0.0f, -1.0f,  0.0f), glm::vec2(0.0f, 1.0f), glm::vec3(0.0f, 0.0f, 0.0f) },
-        Vertex { glm::vec3( 0.5f, -0.5f, -0.5f), glm::vec3( 0.0f, -1.0f,  0.0f), glm::vec2(1.0f, 1.0f), glm::vec3(0.0f, 0.0f, 0.0f) },
-        Vertex { glm::vec3( 0.5f, -0.5f,  0.5f), glm::vec3( 0.0f, -1.0f,  0.0f), glm::vec2(1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f) },
-        Vertex { glm::vec3(-0.5f, -0.5f,  0.5f), glm::vec3( 0.0f, -1.0f,  0.0f), glm::vec2(0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f) },
-
-        Vertex { glm::vec3(-0.5f,  0.5f, -0.5f), glm::vec3( 0.0f,  1.0f,  0.0f), glm::vec2(0.0f, 1.0f), glm::vec3(0.0f, 0.0f, 0.0f) },
-        Vertex { glm::vec3( 0.5f,  0.5f, -0.5f), glm::vec3( 0.0f,  1.0f,  0.0f), glm::vec2(1.0f, 1.0f), glm::vec3(0.0f, 0.0f, 0.0f) },
-        Vertex { glm::vec3( 0.5f,  0.5f,  0.5f), glm::vec3( 0.0f,  1.0f,  0.0f), glm::vec2(1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f) },
-        Vertex { glm::vec3(-0.5f,  0.5f,  0.5f), glm::vec3( 0.0f,  1.0f,  0.0f), glm::vec2(0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f) },
+    auto PackSnorm = [](float value) -> int16_t {
+        return (int16_t)std::round(glm::clamp(value, -1.0f, 1.0f) * 32767.0f);
     };
-
-    std::vector<uint32_t> indices = {
-        0,  2,  1,  2,  0,  3,
-        4,  5,  6,  6,  7,  4,
-        8,  9, 10, 10, 11,  8,
-        12, 14, 13, 14, 12, 15,
-        16, 17, 18, 18, 19, 16,
-        20, 22, 21, 22, 20, 23,
+    auto PackUnorm = [](float value) -> uint16_t {
+        return (uint16_t)std::round(glm::clamp(value, 0.0f, 1.0f) * 65535.0f);
     };
 
-    return Create(vertices, indices, GL_TRIANGLES);
+    glm::vec3 minPos(0.0f), maxPos(0.0f);
+    halfTexCoord = false;
+    for (size_t i = 0; i < vertices.size(); i++) {
+        auto& v = vertices[i];
+        minPos = i == 0 ? v.position : glm::min(minPos, v.position);
+        maxPos = i == 0 ? v.position : glm::max(maxPos, v.position);
+        if (v.texCoord.x < 0.0f || v.texCoord.x > 1.0f || v.texCoord.y < 0.0f || v.texCoord.y > 1.0f)
+            halfTexCoord = true;
+    }
+    glm::vec3 center = (minPos + maxPos) * 0.5f;
+    glm::vec3 halfExtent = (maxPos - minPos) * 0.5f;
+    glm::vec3 invExtent(0.0f);
+    for (int k = 0; k < 3; k++)
+        invExtent[k] = halfExtent[k] > 0.0f ? 1.0f / halfExtent[k] : 0.0f;
+
+    packedVertices.resize(vertices.size());
+    for (size_t i = 0; i < vertices.size(); i++) {
+        auto& v = vertices[i];
+        auto& p = packedVertices[i];
+
+        glm::vec3 position = (v.position - center) * invExtent;
+        p.position[0] = PackSnorm(position.x);
+        p.position[1] = PackSnorm(position.y);
+        p.position[2] = PackSnorm(position.z);
+        p.position[3] = 0;
+
+        // 정팔면체에 투영한 뒤 아래쪽 반구는 바깥 삼각형으로 접어서 2차원으로 저장
+        // 복원 : n = (e.x, e.y, 1 - |e.x| - |e.y|), n.z < 0 이면 n.xy = (1 - |n.yx|) * sign(n.xy)
+        glm::vec3 n = v.normal;
+        float length = fabsf(n.x) + fabsf(n.y) + fabsf(n.z);
+        glm::vec2 e(0.0f);
+        if (length > 0.0f) {
+            n = n / length;
+            e = glm::vec2(n.x, n.y);
+            if (n.z < 0.0f) {
+                e = glm::vec2((1.0f - fabsf(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f),
+                    (1.0f - fabsf(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f));
+            }
+        }
+        p.normal[0] = PackSnorm(e.x);
+        p.normal[1] = PackSnorm(e.y);
+
+        if (halfTexCoord) {
+            p.texCoord[0] = glm::packHalf1x16(v.texCoord.x);
+            p.texCoord[1] = glm::packHalf1x16(v.texCoord.y);
+        }
+        else {
+            p.texCoord[0] = PackUnorm(v.texCoord.x);
+            p.texCoord[1] = PackUnorm(v.texCoord.y);
+        }
+    }
+
+    return glm::translate(glm::mat4(1.0f), center) * glm::scale(glm::mat4(1.0f), halfExtent);
 }
 
-MeshUPtr Mesh::CreatePlane() {
-    std::vector<Vertex> vertices = {
-        Vertex { glm::vec3(-0.5f, -0.5f, 0.0f), glm::vec3( 0.0f,  0.0f, 1.0f), glm::vec2(0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f) },
-        Vertex { glm::vec3( 0.5f, -0.5f, 0.0f), glm::vec3( 0.0f,  0.0f, 1.0f), glm::vec2(1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f) },
-        Vertex { glm::vec3( 0.5f,  0.5f, 0.0f), glm::vec3( 0.0f,  0.0f, 1.0f), glm::vec2(1.0f, 1.0f), glm::vec3(0.0f, 0.0f, 0.0f) },
-        Vertex { glm::vec3(-0.5f,  0.5f, 0.0f), glm::vec3( 0.0f,  0.0f, 1.0f), glm::vec2(0.0f, 1.0f), glm::vec3(0.0f, 0.0f, 0.0f) },
-    };
+void Mesh::UnpackVertices(const std::vector<PackedVertex>& packedVertices,
+    const glm::mat4& positionTransform, bool halfTexCoord, std::vector<Vertex>& vertices) {
 
-    std::vector<uint32_t> indices = {
-        0,  1,  2,  2,  3,  0,
+    auto UnpackSnorm = [](int16_t value) {
+        return std::max((float)value / 32767.0f, -1.0f);
     };
 
-    return Create(vertices, indices, GL_TRIANGLES);
-}
+    vertices.resize(packedVertices.size());
+    for (size_t i = 0; i < packedVertices.size(); i++) {
+        auto& p = packedVertices[i];
+        auto& v = vertices[i];
 
-MeshUPtr Mesh::CreateCylinder(const float radius, const float height, const float rate){
-    std::vector<Vertex> vertices;
-    std::vector<uint32_t> indices;
-    const int numSlices = 50;
-
-    float textureRadius = 0.218f;
-    float textureIncrement = 0.958f / static_cast<float>(numSlices);
-
-    // Create the top cap vertices.
-    glm::vec3 topCenter = glm::vec3(0.0f, height / 2.0f, 0.0f);
-    vertices.push_back(Vertex{topCenter, glm::vec3(0.0f, 1.0f, 0.0f), glm::vec2(0.717f, 0.740f), glm::vec3(0.0f, 0.0f, 0.0f)});
-    float angleIncrement = glm::two_pi<float>() / numSlices;
-    float topRadius = radius * rate;
-    for (int i = 0; i < numSlices; i++) {
-        float angle = angleIncrement * i;
-        glm::vec3 pos = glm::vec3(glm::cos(angle) * topRadius, height / 2.0f, glm::sin(angle) * topRadius);
-        vertices.push_back(Vertex{pos, glm::vec3(0.0f, 1.0f, 0.0f),
-            glm::vec2(0.717f + textureRadius * glm::cos(angle), 0.740f - textureRadius * glm::sin(angle)), glm::vec3(0.0f, 0.0f, 0.0f)});
-    }
+        glm::vec4 position(UnpackSnorm(p.position[0]), UnpackSnorm(p.position[1]), UnpackSnorm(p.position[2]), 1.0f);
+        v.position = glm::vec3(positionTransform * position);
 
-    // Create the bottom cap vertices.
-    glm::vec3 bottomCenter = glm::vec3(0.0f, -height / 2.0f, 0.0f);
-    vertices.push_back(Vertex{bottomCenter, glm::vec3(0.0f, -1.0f, 0.0f), glm::vec2(0.717f, 0.740f), glm::vec3(0.0f, 0.0f, 0.0f)});
-    for (int i = 0; i < numSlices; i++) {
-        float angle = angleIncrement * i;
-        glm::vec3 pos = glm::vec3(glm::cos(angle) * radius, -height / 2.0f, glm::sin(angle) * radius);
-        vertices.push_back(Vertex{pos, glm::vec3(0.0f, -1.0f, 0.0f),
-            glm::vec2(0.717f + textureRadius * glm::cos(angle), 0.740f - textureRadius * glm::sin(angle)), glm::vec3(0.0f, 0.0f, 0.0f)});
-    }
+        glm::vec2 e(UnpackSnorm(p.normal[0]), UnpackSnorm(p.normal[1]));
+        glm::vec3 n(e.x, e.y, 1.0f - fabsf(e.x) - fabsf(e.y));
+        if (n.z < 0.0f) {
+            n.x = (1.0f - fabsf(e.y)) * (e.x >= 0.0f ? 1.0f : -1.0f);
+            n.y = (1.0f - fabsf(e.x)) * (e.y >= 0.0f ? 1.0f : -1.0f);
+        }
+        v.normal = glm::length(n) > 0.0f ? glm::normalize(n) : n;
 
-    // Create the side vertices.
-    for (int i = 0; i < numSlices; i++) {
-        float angle = angleIncrement * i;
-        float increment = textureIncrement * i;
-        glm::vec3 posTop = glm::vec3(glm::cos(angle) * topRadius, height / 2.0f, glm::sin(angle) * topRadius);
-        vertices.push_back(Vertex{posTop, glm::normalize(glm::vec3(glm::cos(angle) * radius, radius / height * (radius - topRadius),
-            glm::sin(angle) * radius)), glm::vec2(0.976f - increment, 0.474f), glm::vec3(0.0f, 0.0f, 0.0f)});
-    }
-    for (int i = 0; i < numSlices; i++) {
-        float angle = angleIncrement * i;
-        float increment = textureIncrement * i;
-        glm::vec3 posBottom = glm::vec3(glm::cos(angle) * radius, -height / 2.0f, glm::sin(angle) * radius);
-        vertices.push_back(Vertex{posBottom, glm::normalize(glm::vec3(glm::cos(angle) * radius, radius / height * (radius - topRadius),
-            glm::sin(angle) * radius)), glm::vec2(0.976f - increment, 0.118f), glm::vec3(0.0f, 0.0f, 0.0f)});
+        if (halfTexCoord)
+            v.texCoord = glm::vec2(glm::unpackHalf1x16(p.texCoord[0]), glm::unpackHalf1x16(p.texCoord[1]));
+        else
+            v.texCoord = glm::vec2(p.texCoord[0] / 65535.0f, p.texCoord[1] / 65535.0f);
+        v.tangent = glm::vec3(0.0f);
     }
+}
 
-    // Create the top cap indices.
-    for (int i = 1; i < numSlices; i++) {
-        indices.push_back(0);
-        indices.push_back(i + 1);
-        indices.push_back(i);
-    }
-    indices.push_back(0);
-    indices.push_back(numSlices);
-    indices.push_back(1);
-
-    // Create the bottom cap indices.
-    int bottomCenterIndex = numSlices + 1;
-    for (int i = bottomCenterIndex + 1; i < bottomCenterIndex + numSlices; i++) {
-        indices.push_back(bottomCenterIndex);
-        indices.push_back(i);
-        indices.push_back(i + 1);
+// 그릴 수 없는 형식이면 false
+bool Mesh::Bind(const Program* program) const {
+    // Packed의 location 1은 octahedral normal (vec2)이므로 vec3 normal로 읽으면 조명이 잘못 계산됨
+    if (m_format == VertexFormat::Packed && program->IsAttribActive(1)) {
+        if (!m_formatErrorLogged) {
+            SPDLOG_ERROR("packed mesh cannot be drawn with a program that reads normals (location 1)");
+            m_formatErrorLogged = true;
+        }
+        return false;
     }
-    indices.push_back(bottomCenterIndex);
-    indices.push_back(numSlices * 2 + 1);
-    indices.push_back(bottomCenterIndex + 1);
-
-    // Create the side indices.
-    for (int i = numSlices * 2 + 2; i < numSlices * 3 + 1; i++){
-        indices.push_back(i + numSlices + 1);
-        indices.push_back(i + numSlices);
-        indices.push_back(i);
-        indices.push_back(i);
-        indices.push_back(i + 1);
-        indices.push_back(i + numSlices + 1);
+    m_vertexLayout->Bind();
+    if (m_material) {
+        m_material->SetToProgram(program);
     }
-    indices.push_back(numSlices * 3 + 2);
-    indices.push_back(numSlices * 4 + 1);
-    indices.push_back(numSlices * 3 + 1);
-    indices.push_back(numSlices * 3 + 1);
-    indices.push_back(numSlices * 2 + 2);
-    indices.push_back(numSlices * 3 + 2);
-
-    return Create(vertices, indices, GL_TRIANGLES);
+    return true;
 }
 
-MeshUPtr Mesh::CreateLeaf(float width, float height) {
-    std::vector<Vertex> vertices = {
-        Vertex { glm::vec3( 0.0f,  0.0f, width / 2.0f), glm::vec3( 1.0f,  0.0f, 0.0f), glm::vec2(0.0f, 0.5f), glm::vec3(0.0f, 0.0f, 0.0f) },
-        Vertex { glm::vec3( 0.0f,  0.0f, width / -2.0f), glm::vec3( 1.0f,  0.0f, 0.0f), glm::vec2(0.47f, 0.5f), glm::vec3(0.0f, 0.0f, 0.0f) },
-        Vertex { glm::vec3( 0.0f,  height, width / -2.0f), glm::vec3( 1.0f,  0.0f, 0.0f), glm::vec2(0.47f, 1.0f), glm::vec3(0.0f, 0.0f, 0.0f) },
-        Vertex { glm::vec3( 0.0f,  height, width / 2.0f), glm::vec3( 1.0f,  0.0f, 0.0f), glm::vec2(0.0f, 1.0f), glm::vec3(0.0f, 0.0f, 0.0f) },
-
-        Vertex { glm::vec3( 0.0f,  0.0f, width / 2.0f), glm::vec3( -1.0f,  0.0f, 0.0f), glm::vec2(0.0f, 0.5f), glm::vec3(0.0f, 0.0f, 0.0f) },
-        Vertex { glm::vec3( 0.0f,  0.0f, width / -2.0f), glm::vec3( -1.0f,  0.0f, 0.0f), glm::vec2(0.47f, 0.5f), glm::vec3(0.0f, 0.0f, 0.0f) },
-        Vertex { glm::vec3( 0.0f,  height, width / -2.0f), glm::vec3( -1.0f,  0.0f, 0.0f), glm::vec2(0.47f, 1.0f), glm::vec3(0.0f, 0.0f, 0.0f) },
-        Vertex { glm::vec3( 0.0f,  height, width / 2.0f), glm::vec3( -1.0f,  0.0f, 0.0f), glm::vec2(0.0f, 1.0f), glm::vec3(0.0f, 0.0f, 0.0f) },
-    };
-
-    std::vector<uint32_t> indices = {
-        0, 1, 2, 2, 3, 0,
-        4, 7, 5, 5, 7, 6
-    };
-
-    return Create(vertices, indices, GL_TRIANGLES);
+void Mesh::Draw(const Program* program) const {
+    if (!Bind(program))
+        return;
+    glDrawElements(m_primitiveType, m_indexBuffer->GetCount(), GL_UNSIGNED_INT, 0);
+    FrameProfiler::CountDraw(m_primitiveType, m_indexBuffer->GetCount());
 }
 
-MeshUPtr Mesh::CreateSphere(float radius) {
-    std::vector<Vertex> vertices;
-    std::vector<uint32_t> indices;
-
-    const int stacks = 15;
-    const int slices = 30;
-    float theta, phi;
-
-    for(int i = 0; i <= stacks; i++) {
-        phi = M_PI / 2 - i * M_PI / stacks;
-        for(int j = 0; j <= slices; j++) {
-            theta = j * 2 * M_PI / slices;
+void Mesh::SetInstanceBuffer(BufferPtr buffer, uint32_t location, int rowCount, uint32_t type) {
+    m_instanceBuffer = std::move(buffer);
+    m_vertexLayout->Bind();
+    m_instanceBuffer->Bind();
+    size_t stride = m_instanceBuffer->GetStride();
+    for (int i = 0; i < rowCount; i++) {
+        m_vertexLayout->SetAttrib(location + i, 4, type, false, stride, stride / rowCount * i);
+        m_vertexLayout->SetAttribDivisor(location + i, 1);
+    }
+}
 
-            float xn = cos(phi) * sin(theta);
-            float yn = sin(phi);
-            float zn = cos(phi) * cos(theta);
+void Mesh::DrawInstanced(const Program* program, size_t instanceCount) const {
+    if (!m_instanceBuffer || instanceCount == 0 || !Bind(program))
+        return;
+    glDrawElementsInstanced(m_primitiveType, m_indexBuffer->GetCount(), GL_UNSIGNED_INT, 0, (GLsizei)instanceCount);
+    FrameProfiler::CountDraw(m_primitiveType, m_indexBuffer->GetCount(), instanceCount);
+}
 
-            vertices.push_back(Vertex { glm::vec3(radius * xn, radius * yn + radius / 2, radius * zn),
-                glm::vec3(xn, yn, zn), glm::vec2(0.0f), glm::vec3(0.0f)});
-        }
-    }
+MeshUPtr Mesh::CreateBox() {
+    auto data = MakeBoxMeshData();
+    return Create(data.vertices, data.indices, GL_TRIANGLES);
+}
 
-    for(int i = 0; i < stacks; i++) {
-        for(int j = 0; j < slices; j++) {
-            int currRow = i * (slices + 1); // slices 총 slices + 1개씩 생성
-            int nextRow = (i + 1) * (slices + 1);
+MeshUPtr Mesh::CreatePlane() {
+    auto data = MakePlaneMeshData();
+    return Create(data.vertices, data.indices, GL_TRIANGLES);
+}
 
-            indices.push_back(currRow + j);
-            indices.push_back(nextRow + j);
-            indices.push_back(nextRow + j + 1);
+MeshUPtr Mesh::CreateCylinder(const float radius, const float height, const float rate,
+    const MeshOptions& options){
+    auto data = MakeCylinderMeshData(radius, height, rate);
+    return Create(data.vertices, data.indices, GL_TRIANGLES, options);
+}
 
-            indices.push_back(nextRow + j + 1);
-            indices.push_back(currRow + j + 1);
-            indices.push_back(currRow + j);
-        }
-    }
+MeshUPtr Mesh::CreateLeaf(float width, float height, const MeshOptions& options) {
+    auto data = MakeLeafMeshData(width, height);
+    return Create(data.vertices, data.indices, GL_TRIANGLES, options);
+}
 
-    return Create(vertices, indices, GL_TRIANGLES);
+MeshUPtr Mesh::CreateSphere(float radius, const MeshOptions& options) {
+    auto data = MakeSphereMeshData(radius);
+    return Create(data.vertices, data.indices, GL_TRIANGLES, options);
 }
 
 // MeshUPtr Mesh::CreateLsysLeaf(float width, float height) {
@@ -307,56 +367,4 @@ void Material::SetToProgram(const Program* program) const {
     }
     glActiveTexture(GL_TEXTURE0);
     program->SetUniform("material.shininess", shininess);
-}
-
-void Mesh::ComputeTangents(std::vector<Vertex>& vertices,
-    const std::vector<uint32_t>& indices) {
-
-    auto compute = [](
-        const glm::vec3& pos1, const glm::vec3& pos2, const glm::vec3& pos3,
-        const glm::vec2& uv1, const glm::vec2& uv2, const glm::vec2& uv3)
-        -> glm::vec3 {
-
-        auto edge1 = pos2 - pos1;
-        auto edge2 = pos3 - pos1;
-        auto deltaUV1 = uv2 - uv1;
-        auto deltaUV2 = uv3 - uv1;
-        float det = (deltaUV1.x * deltaUV2.y - deltaUV1.y * deltaUV2.x);
-        if (det != 0.0f) {
-            auto invDet = 1.0f / det;
-            return invDet * (deltaUV2.y * edge1 - deltaUV1.y * edge2);
-        }
-        else {
-            return glm::vec3(0.0f, 0.0f, 0.0f);
-        }
-    };
-
-    // initialize
-    std::vector<glm::vec3> tangents;
-    tangents.resize(vertices.size());
-    memset(tangents.data(), 0, tangents.size() * sizeof(glm::vec3));
-
-    // accumulate triangle tangents to each vertex
-    for (size_t i = 0; i < indices.size(); i += 3) {
-        auto v1 = indices[i  ];
-        auto v2 = indices[i+1];
-        auto v3 = indices[i+2];
-
-        tangents[v1] += compute(
-            vertices[v1].position, vertices[v2].position, vertices[v3].position,
-            vertices[v1].texCoord, vertices[v2].texCoord, vertices[v3].texCoord);
-
-        tangents[v2] = compute(
-            vertices[v2].position, vertices[v3].position, vertices[v1].position,
-            vertices[v2].texCoord, vertices[v3].texCoord, vertices[v1].texCoord);
-
-        tangents[v3] = compute(
-            vertices[v3].position, vertices[v1].position, vertices[v2].position,
-            vertices[v3].texCoord, vertices[v1].texCoord, vertices[v2].texCoord);
-    }
-
-    // normalize
-    for (size_t i = 0; i < vertices.size(); i++) {
-        vertices[i].tangent = glm::normalize(tangents[i]);
-    }
 }
\ No newline at end of file
@@ -6,12 +6,47 @@
 #include "vertex_layout.h"
 #include "texture.h"
 #include "program.h"
+#include "mesh_data.h"
+
+/*
+GPU에 올라가는 vertex 형식
+Float : Vertex 그대로 (44 bytes)
+Packed : PackedVertex (16 bytes)
+    position : mesh bounds 기준 normalized int16, GetPositionTransform()을 transform에 곱해서 복원
+    normal : octahedral encoding (normalized int16 x 2), location 1의 normal (vec3)을 읽는 program으로는 Draw하지 않음
+    texCoord : [0, 1] 범위면 normalized uint16, 벗어나면 half float
+    tangent : 없음
+*/
+enum class VertexFormat {
+    Float,
+    Packed,
+};
+
+struct PackedVertex {
+    int16_t position[4]; // w는 정렬용
+    int16_t normal[2];
+    uint16_t texCoord[2];
+};
 
-struct Vertex {
-    glm::vec3 position;
-    glm::vec3 normal;
-    glm::vec2 texCoord;
-    glm::vec3 tangent;
+/*
+GPU에 올린 데이터의 CPU 사본 관리
+None : 업로드 후 바로 버림
+Retained : 계속 들고 있음
+ReadBack : 버리고, GetVertices / GetIndices 호출 시 GPU 버퍼에서 다시 읽어옴
+*/
+enum class CpuRetention {
+    None,
+    Retained,
+    ReadBack,
+};
+
+struct MeshOptions {
+    VertexFormat format { VertexFormat::Float };
+    CpuRetention retention { CpuRetention::Retained };
+    // normal map을 쓰는 mesh만 필요 (Float 형식에서만 의미 있음)
+    bool computeTangents { false };
+    // GL_TRIANGLES면 업로드 전에 Optimize 적용
+    bool optimize { true };
 };
 
 CLASS_PTR(Material);
@@ -34,43 +69,80 @@ CLASS_PTR(Mesh);
 class Mesh {
 public:
     static MeshUPtr Create(const std::vector<Vertex>& vertices,
-        const std::vector<uint32_t>& indices,uint32_t primitiveType);
+        const std::vector<uint32_t>& indices,uint32_t primitiveType,
+        const MeshOptions& options = MeshOptions());
+    // 버퍼 메모리만 할당, 데이터는 버퍼의 SetSubData로 나눠서 업로드
+    static MeshUPtr CreateEmpty(size_t vertexCount, size_t indexCount, uint32_t primitiveType);
 
     static MeshUPtr CreateBox();
     static MeshUPtr CreatePlane();
-    static MeshUPtr CreateCylinder(float radius = 0.5f, float height = 1.0f, float rate = 1.0f);
-    static MeshUPtr CreateLeaf(float width = 0.1f, float height = 0.1f);
-    static MeshUPtr CreateSphere(float radius = 0.1f);
+    static MeshUPtr CreateCylinder(float radius = 0.5f, float height = 1.0f, float rate = 1.0f,
+        const MeshOptions& options = MeshOptions());
+    static MeshUPtr CreateLeaf(float width = 0.1f, float height = 0.1f,
+        const MeshOptions& options = MeshOptions());
+    static MeshUPtr CreateSphere(float radius = 0.1f,
+        const MeshOptions& options = MeshOptions());
     static MeshUPtr CreateLsysLeaf(float width = 0.02f, float height = 0.1f);
 
     const VertexLayout* GetVertexLayout() const { return m_vertexLayout.get(); }
     BufferPtr GetVertexBuffer() const { return m_vertexBuffer; }
     BufferPtr GetIndexBuffer() const { return m_indexBuffer; }
+    VertexFormat GetVertexFormat() const { return m_format; }
+    // Packed 형식의 position 복원 행렬 (Float 형식은 단위 행렬)
+    const glm::mat4& GetPositionTransform() const { return m_positionTransform; }
 
     void SetMaterial(MaterialPtr material) { m_material = material; }
     MaterialPtr GetMaterial() const { return m_material; }
 
+    // Packed 형식은 program이 location 1 (normal)을 사용하면 그리지 않고 에러 출력 (한 번만)
     void Draw(const Program* program) const;
-
-    static void ComputeTangents(std::vector<Vertex>& vertices,
-        const std::vector<uint32_t>& indices);
-
-    std::vector<Vertex> GetVertexVector() { return m_vertexVector; }
-    std::vector<int> GetIndexVector() { return m_indexVector; }
+    // location부터 vec4 rowCount개를 instance마다 buffer에서 읽음 (type은 성분 형식, 정규화하지 않음)
+    // vertex attribute (0 ~ 3)와 겹치지 않는 location을 사용
+    void SetInstanceBuffer(BufferPtr buffer, uint32_t location, int rowCount, uint32_t type);
+    // SetInstanceBuffer의 instance를 instanceCount개 한 번에 그림
+    void DrawInstanced(const Program* program, size_t instanceCount) const;
+
+    // vertex를 PackedVertex로 변환하고 position 복원 행렬을 반환
+    static glm::mat4 PackVertices(const std::vector<Vertex>& vertices,
+        std::vector<PackedVertex>& packedVertices, bool& halfTexCoord);
+    static void UnpackVertices(const std::vector<PackedVertex>& packedVertices,
+        const glm::mat4& positionTransform, bool halfTexCoord, std::vector<Vertex>& vertices);
+
+    // vertex cache / overdraw / vertex fetch 순서 최적화 (GL_TRIANGLES 전용)
+    // MeshOptions::optimize가 켜져 있으면 Init에서 적용, 최적화 전후 ACMR은 debug 로그로 출력
+    static void Optimize(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+    // CPU 사본을 복사 없이 반환, None이면 비어있음
+    // ReadBack이면 처음 호출할 때 GPU에서 읽어오고 ReleaseCpuCopy 전까지 유지
+    Span<const Vertex> GetVertices();
+    Span<const uint32_t> GetIndices();
+    void ReleaseCpuCopy();
+    CpuRetention GetCpuRetention() const { return m_retention; }
 
 private:
     Mesh() {}
     void Init(const std::vector<Vertex>& vertices,
-        const std::vector<uint32_t>& indices, uint32_t primitiveType);
+        const std::vector<uint32_t>& indices, uint32_t primitiveType,
+        const MeshOptions& options);
+    void InitBuffers(const void* vertices, size_t vertexCount,
+        const uint32_t* indices, size_t indexCount, uint32_t primitiveType);
+    void ReadBack();
+    bool Bind(const Program* program) const;
 
     uint32_t m_primitiveType { GL_TRIANGLES };
+    VertexFormat m_format { VertexFormat::Float };
+    bool m_halfTexCoord { false };
+    mutable bool m_formatErrorLogged { false };
+    glm::mat4 m_positionTransform { 1.0f };
+    CpuRetention m_retention { CpuRetention::Retained };
     VertexLayoutUPtr m_vertexLayout;
     BufferPtr m_vertexBuffer;
     BufferPtr m_indexBuffer;
+    BufferPtr m_instanceBuffer;
 
     MaterialPtr m_material;
     std::vector<Vertex> m_vertexVector;
-    std::vector<int> m_indexVector;
+    std::vector<uint32_t> m_indexVector;
     int m_numSlices = 50;
 };
 
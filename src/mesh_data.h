@@ -0,0 +1,22 @@
+#ifndef __MESH_DATA_H__
+#define __MESH_DATA_H__
+
+#include "core_common.h"
+#include <vector>
+
+struct Vertex {
+    glm::vec3 position;
+    glm::vec3 normal;
+    glm::vec2 texCoord;
+    glm::vec3 tangent;
+};
+
+// GL 리소스를 만들기 전 단계의 mesh 데이터 (워커 스레드에서 생성 가능)
+struct MeshData {
+    std::string name;
+    int materialIndex { -1 };
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+};
+
+#endif // __MESH_DATA_H__
\ No newline at end of file
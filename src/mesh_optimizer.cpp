@@ -0,0 +1,263 @@
+#include "mesh_optimizer.h"
+#include <algorithm>
+#include <numeric>
+
+namespace {
+
+// Tom Forsyth, "Linear-Speed Vertex Cache Optimisation" 의 점수 함수
+const int FORSYTH_CACHE_SIZE = 32;
+const float CACHE_DECAY_POWER = 1.5f;
+const float LAST_TRIANGLE_SCORE = 0.75f;
+const float VALENCE_BOOST_SCALE = 2.0f;
+const float VALENCE_BOOST_POWER = 0.5f;
+
+float VertexScore(int cachePosition, uint32_t remainingValence) {
+    // 더 이상 사용하는 삼각형이 없는 vertex
+    if (remainingValence == 0)
+        return -1.0f;
+
+    float score = 0.0f;
+    if (cachePosition >= 0) {
+        // 방금 그린 삼각형의 vertex는 고정 점수를 줘서 바로 옆 삼각형만 고르는 것을 방지
+        if (cachePosition < 3) {
+            score = LAST_TRIANGLE_SCORE;
+        }
+        else {
+            float scaler = 1.0f / (FORSYTH_CACHE_SIZE - 3);
+            score = powf(1.0f - (cachePosition - 3) * scaler, CACHE_DECAY_POWER);
+        }
+    }
+    // 남은 삼각형이 적은 vertex를 먼저 처리해서 외톨이 삼각형이 생기지 않도록 함
+    score += VALENCE_BOOST_SCALE * powf((float)remainingValence, -VALENCE_BOOST_POWER);
+    return score;
+}
+
+} // namespace
+
+float ComputeACMR(const std::vector<uint32_t>& indices, size_t vertexCount, int cacheSize) {
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0)
+        return 0.0f;
+
+    // FIFO 캐시 : 마지막으로 캐시에 들어간 시점이 cacheSize 이내면 적중
+    std::vector<uint32_t> cacheTime(vertexCount, 0);
+    uint32_t time = (uint32_t)cacheSize + 1;
+    size_t misses = 0;
+    for (auto index : indices) {
+        if (time - cacheTime[index] > (uint32_t)cacheSize) {
+            cacheTime[index] = time++;
+            misses++;
+        }
+    }
+    return (float)misses / (float)triangleCount;
+}
+
+void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount) {
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount < 2)
+        return;
+
+    // vertex마다 아직 그리지 않은 인접 삼각형 목록
+    // adjacency[offset[v], offset[v] + valence[v]) 구간이 남은 삼각형
+    std::vector<uint32_t> valence(vertexCount, 0);
+    for (auto index : indices)
+        valence[index]++;
+    std::vector<uint32_t> offset(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; v++)
+        offset[v + 1] = offset[v] + valence[v];
+    std::vector<uint32_t> adjacency(indices.size());
+    std::vector<uint32_t> fill(offset.begin(), offset.end() - 1);
+    for (size_t t = 0; t < triangleCount; t++) {
+        for (int k = 0; k < 3; k++)
+            adjacency[fill[indices[3 * t + k]]++] = (uint32_t)t;
+    }
+
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> vertexScore(vertexCount);
+    for (size_t v = 0; v < vertexCount; v++)
+        vertexScore[v] = VertexScore(-1, valence[v]);
+
+    std::vector<float> triangleScore(triangleCount);
+    std::vector<bool> emitted(triangleCount, false);
+    int best = 0;
+    for (size_t t = 0; t < triangleCount; t++) {
+        triangleScore[t] = vertexScore[indices[3 * t]] + vertexScore[indices[3 * t + 1]] + vertexScore[indices[3 * t + 2]];
+        if (triangleScore[t] > triangleScore[best])
+            best = (int)t;
+    }
+
+    auto UpdateScore = [&](uint32_t v) {
+        float score = VertexScore(cachePosition[v], valence[v]);
+        float delta = score - vertexScore[v];
+        vertexScore[v] = score;
+        for (uint32_t i = offset[v]; i < offset[v] + valence[v]; i++)
+            triangleScore[adjacency[i]] += delta;
+    };
+
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> newCache;
+    cache.reserve(FORSYTH_CACHE_SIZE + 3);
+    newCache.reserve(FORSYTH_CACHE_SIZE + 3);
+    size_t cursor = 0;
+
+    for (size_t count = 0; count < triangleCount; count++) {
+        // 캐시 안에 후보 삼각형이 없으면 아직 그리지 않은 삼각형 중 앞에서부터 선택
+        if (best < 0) {
+            while (emitted[cursor])
+                cursor++;
+            best = (int)cursor;
+        }
+
+        const uint32_t* triangle = &indices[3 * best];
+        newCache.clear();
+        for (int k = 0; k < 3; k++) {
+            uint32_t v = triangle[k];
+            result.push_back(v);
+            newCache.push_back(v);
+
+            auto begin = adjacency.begin() + offset[v];
+            auto end = begin + valence[v];
+            auto it = std::find(begin, end, (uint32_t)best);
+            std::iter_swap(it, end - 1);
+            valence[v]--;
+        }
+        emitted[best] = true;
+
+        for (auto v : cache) {
+            if (v != triangle[0] && v != triangle[1] && v != triangle[2])
+                newCache.push_back(v);
+        }
+        for (size_t i = FORSYTH_CACHE_SIZE; i < newCache.size(); i++) {
+            cachePosition[newCache[i]] = -1;
+            UpdateScore(newCache[i]);
+        }
+        if (newCache.size() > FORSYTH_CACHE_SIZE)
+            newCache.resize(FORSYTH_CACHE_SIZE);
+        cache.swap(newCache);
+
+        for (size_t i = 0; i < cache.size(); i++) {
+            cachePosition[cache[i]] = (int)i;
+            UpdateScore(cache[i]);
+        }
+
+        best = -1;
+        float bestScore = -1.0f;
+        for (auto v : cache) {
+            for (uint32_t i = offset[v]; i < offset[v] + valence[v]; i++) {
+                uint32_t t = adjacency[i];
+                if (triangleScore[t] > bestScore) {
+                    bestScore = triangleScore[t];
+                    best = (int)t;
+                }
+            }
+        }
+    }
+
+    indices.swap(result);
+}
+
+void OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices) {
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount < 2)
+        return;
+
+    // 세 vertex 모두 캐시에 없는 삼각형부터 새로운 묶음 시작
+    // 묶음 경계에서는 어차피 캐시가 비어있으므로 묶음 순서를 바꿔도 ACMR이 거의 변하지 않음
+    std::vector<uint32_t> clusters;
+    std::vector<uint32_t> cacheTime(vertices.size(), 0);
+    uint32_t time = VERTEX_CACHE_SIZE + 1;
+    for (size_t t = 0; t < triangleCount; t++) {
+        int misses = 0;
+        for (int k = 0; k < 3; k++) {
+            uint32_t v = indices[3 * t + k];
+            if (time - cacheTime[v] > VERTEX_CACHE_SIZE) {
+                cacheTime[v] = time++;
+                misses++;
+            }
+        }
+        if (misses == 3 || t == 0)
+            clusters.push_back((uint32_t)t);
+    }
+    if (clusters.size() < 2)
+        return;
+    clusters.push_back((uint32_t)triangleCount);
+
+    auto TriangleCross = [&](size_t t) {
+        auto& p0 = vertices[indices[3 * t]].position;
+        auto& p1 = vertices[indices[3 * t + 1]].position;
+        auto& p2 = vertices[indices[3 * t + 2]].position;
+        return glm::cross(p1 - p0, p2 - p0);
+    };
+    auto TriangleCenter = [&](size_t t) {
+        return (vertices[indices[3 * t]].position + vertices[indices[3 * t + 1]].position +
+            vertices[indices[3 * t + 2]].position) / 3.0f;
+    };
+
+    // 면적 가중 중심
+    glm::vec3 meshCenter(0.0f);
+    float meshArea = 0.0f;
+    for (size_t t = 0; t < triangleCount; t++) {
+        float area = glm::length(TriangleCross(t));
+        meshCenter += TriangleCenter(t) * area;
+        meshArea += area;
+    }
+    if (meshArea > 0.0f)
+        meshCenter = meshCenter / meshArea;
+
+    // 바깥을 향하는 묶음일수록 앞에 있는 다른 면을 가릴 가능성이 높으므로 먼저 그림
+    size_t clusterCount = clusters.size() - 1;
+    std::vector<float> sortKey(clusterCount);
+    for (size_t c = 0; c < clusterCount; c++) {
+        glm::vec3 normal(0.0f);
+        glm::vec3 center(0.0f);
+        float area = 0.0f;
+        for (size_t t = clusters[c]; t < clusters[c + 1]; t++) {
+            auto cross = TriangleCross(t);
+            float triangleArea = glm::length(cross);
+            normal += cross;
+            center += TriangleCenter(t) * triangleArea;
+            area += triangleArea;
+        }
+        float normalLength = glm::length(normal);
+        if (area <= 0.0f || normalLength <= 0.0f) {
+            sortKey[c] = 0.0f;
+            continue;
+        }
+        sortKey[c] = glm::dot(normal / normalLength, center / area - meshCenter);
+    }
+
+    std::vector<uint32_t> order(clusterCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return sortKey[a] > sortKey[b];
+    });
+
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+    for (auto c : order) {
+        result.insert(result.end(), indices.begin() + 3 * clusters[c], indices.begin() + 3 * clusters[c + 1]);
+    }
+    indices.swap(result);
+}
+
+void OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+    std::vector<uint32_t> remap(vertices.size(), UINT32_MAX);
+    uint32_t next = 0;
+    for (auto& index : indices) {
+        if (remap[index] == UINT32_MAX)
+            remap[index] = next++;
+        index = remap[index];
+    }
+    // 인덱스에서 쓰이지 않는 vertex도 개수는 유지 (뒤쪽에 모아둠)
+    for (auto& value : remap) {
+        if (value == UINT32_MAX)
+            value = next++;
+    }
+
+    std::vector<Vertex> result(vertices.size());
+    for (size_t v = 0; v < vertices.size(); v++)
+        result[remap[v]] = vertices[v];
+    vertices.swap(result);
+}
\ No newline at end of file
@@ -0,0 +1,23 @@
+#ifndef __MESH_OPTIMIZER_H__
+#define __MESH_OPTIMIZER_H__
+
+#include "core_common.h"
+#include "mesh_data.h"
+#include <vector>
+
+/*
+GL_TRIANGLES 인덱스 순서 최적화
+1. OptimizeVertexCache : Forsyth 알고리즘으로 post-transform vertex cache 적중률이 높은 순서로 삼각형 재배치
+2. OptimizeOverdraw : 캐시가 비워지는 지점을 기준으로 삼각형 묶음을 나누고 바깥을 향하는 묶음부터 그리도록 정렬
+3. OptimizeVertexFetch : 인덱스에서 처음 사용되는 순서대로 vertex 재배치 (사용되지 않는 vertex는 뒤로)
+*/
+const int VERTEX_CACHE_SIZE = 16;
+
+// average cache miss ratio : 삼각형 하나당 vertex shader 실행 횟수 (FIFO 캐시 기준, 0.5 ~ 3.0)
+float ComputeACMR(const std::vector<uint32_t>& indices, size_t vertexCount, int cacheSize = VERTEX_CACHE_SIZE);
+
+void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount);
+void OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices);
+void OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+#endif // __MESH_OPTIMIZER_H__
\ No newline at end of file
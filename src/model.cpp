@@ -1,13 +1,97 @@
 #include "model.h"
+#include "obj_parser.h"
+#include <chrono>
 
 ModelUPtr Model::Load(const std::string& filename) {
-    auto model = ModelUPtr(new Model());
-    if (!model->LoadByAssimp(filename))
+    auto data = LoadData(filename);
+    if (!data)
         return nullptr;
+    return CreateFromData(*data);
+}
+
+std::unique_ptr<ModelData> Model::LoadData(const std::string& filename) {
+    auto data = std::make_unique<ModelData>();
+    // 단순한 OBJ는 자체 파서로 읽고, 지원하지 않는 파일만 Assimp 사용
+    if (LoadByObjParser(filename, *data))
+        return data;
+    *data = ModelData();
+    if (!LoadByAssimp(filename, *data))
+        return nullptr;
+    return data;
+}
+
+ModelUPtr Model::CreateFromData(ModelData& data) {
+    auto model = ModelUPtr(new Model());
+    for (auto& material : data.materials) {
+        auto glMaterial = Material::Create();
+        if (material.diffuse)
+            glMaterial->diffuse = Texture::CreateFromImage(material.diffuse.get());
+        if (material.specular)
+            glMaterial->specular = Texture::CreateFromImage(material.specular.get());
+        glMaterial->shininess = material.shininess;
+        model->m_materials.push_back(std::move(glMaterial));
+    }
+
+    for (auto& mesh : data.meshes) {
+        // 불러온 모델은 export 할 때만 CPU 데이터가 필요하므로 사본을 들고 있지 않음
+        MeshOptions options;
+        options.retention = CpuRetention::ReadBack;
+        auto glMesh = Mesh::Create(mesh.vertices, mesh.indices, GL_TRIANGLES, options);
+        if (mesh.materialIndex >= 0)
+            glMesh->SetMaterial(model->m_materials[mesh.materialIndex]);
+        model->m_meshes.push_back(std::move(glMesh));
+    }
+    return std::move(model);
+}
+
+ModelUPtr Model::CreateFromMeshes(std::vector<MeshPtr> meshes, std::vector<MaterialPtr> materials) {
+    auto model = ModelUPtr(new Model());
+    model->m_meshes = std::move(meshes);
+    model->m_materials = std::move(materials);
     return std::move(model);
 }
 
-bool Model::LoadByAssimp(const std::string& filename) {
+bool Model::LoadByObjParser(const std::string& filename, ModelData& data) {
+    auto pos = filename.find_last_of('.');
+    if (pos == std::string::npos)
+        return false;
+    auto extension = filename.substr(pos + 1);
+    for (auto& c : extension)
+        c = (char)tolower(c);
+    if (extension != "obj")
+        return false;
+
+    auto start = std::chrono::steady_clock::now();
+    auto parser = ObjParser::Parse(filename);
+    if (!parser)
+        return false;
+
+    auto dirname = filename.substr(0, filename.find_last_of("/\\"));
+    auto LoadMaterialImage = [&](const std::string& filepath) -> ImagePtr {
+        if (filepath.empty())
+            return nullptr;
+        return Image::Load(fmt::format("{}/{}", dirname, filepath));
+    };
+
+    for (auto& material : parser->GetMaterials()) {
+        ModelMaterialData materialData;
+        materialData.diffuse = LoadMaterialImage(material.diffuseMap);
+        materialData.specular = LoadMaterialImage(material.specularMap);
+        data.materials.push_back(std::move(materialData));
+    }
+
+    for (auto& mesh : parser->GetMeshes()) {
+        SPDLOG_INFO("Process mesh: {}, #vert: {}, #face: {}",
+            mesh.name, mesh.vertices.size(), mesh.indices.size() / 3);
+        data.meshes.push_back(std::move(mesh));
+    }
+
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+    SPDLOG_INFO("loaded model by obj parser: {} ({:.1f} ms)", filename, elapsed.count());
+    return true;
+}
+
+bool Model::LoadByAssimp(const std::string& filename, ModelData& data) {
     Assimp::Importer importer;
     auto scene = importer.ReadFile(filename, aiProcess_Triangulate | aiProcess_FlipUVs);
 
@@ -17,47 +101,48 @@ bool Model::LoadByAssimp(const std::string& filename) {
     }
 
     auto dirname = filename.substr(0, filename.find_last_of("/"));
-    auto LoadTexture = [&](aiMaterial* material, aiTextureType type) -> TexturePtr {
+    auto LoadMaterialImage = [&](aiMaterial* material, aiTextureType type) -> ImagePtr {
         if (material->GetTextureCount(type) <= 0)
             return nullptr;
         aiString filepath;
         material->GetTexture(type, 0, &filepath);
-        auto image = Image::Load(fmt::format("{}/{}", dirname, filepath.C_Str()));
-        if (!image)
-            return nullptr;
-        return Texture::CreateFromImage(image.get());
+        return Image::Load(fmt::format("{}/{}", dirname, filepath.C_Str()));
     };
 
     for (uint32_t i = 0; i < scene->mNumMaterials; i++) {
         auto material = scene->mMaterials[i];
-        auto glMaterial = Material::Create();
-        glMaterial->diffuse = LoadTexture(material, aiTextureType_DIFFUSE);
-        glMaterial->specular = LoadTexture(material, aiTextureType_SPECULAR);
-        m_materials.push_back(std::move(glMaterial));
+        ModelMaterialData materialData;
+        materialData.diffuse = LoadMaterialImage(material, aiTextureType_DIFFUSE);
+        materialData.specular = LoadMaterialImage(material, aiTextureType_SPECULAR);
+        data.materials.push_back(std::move(materialData));
     }
 
-    ProcessNode(scene->mRootNode, scene);
+    ProcessNode(scene->mRootNode, scene, data);
     return true;
 }
 
 // tree 형식으로 구현
-void Model::ProcessNode(aiNode* node, const aiScene* scene) {
+void Model::ProcessNode(aiNode* node, const aiScene* scene, ModelData& data) {
     for (uint32_t i = 0; i < node->mNumMeshes; i++) {
         auto meshIndex = node->mMeshes[i];
         auto mesh = scene->mMeshes[meshIndex];
-        ProcessMesh(mesh, scene);
+        ProcessMesh(mesh, scene, data);
     }
 
     for (uint32_t i = 0; i < node->mNumChildren; i++) {
-        ProcessNode(node->mChildren[i], scene);
+        ProcessNode(node->mChildren[i], scene, data);
     }
 }
 
-void Model::ProcessMesh(aiMesh* mesh, const aiScene* scene) {
+void Model::ProcessMesh(aiMesh* mesh, const aiScene* scene, ModelData& data) {
     SPDLOG_INFO("Process mesh: {}, #vert: {}, #face: {}",
         mesh->mName.C_Str(), mesh->mNumVertices, mesh->mNumFaces);
 
-    std::vector<Vertex> vertices;
+    MeshData meshData;
+    meshData.name = mesh->mName.C_Str();
+    meshData.materialIndex = (int)mesh->mMaterialIndex;
+
+    auto& vertices = meshData.vertices;
     vertices.resize(mesh->mNumVertices);
     for (uint32_t i = 0; i < mesh->mNumVertices; i++) {
         auto& v = vertices[i];
@@ -66,7 +151,7 @@ void Model::ProcessMesh(aiMesh* mesh, const aiScene* scene) {
         v.texCoord = glm::vec2(mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y);
     }
 
-    std::vector<uint32_t> indices;
+    auto& indices = meshData.indices;
     indices.resize(mesh->mNumFaces * 3);
     for (uint32_t i = 0; i < mesh->mNumFaces; i++) {
         indices[3*i  ] = mesh->mFaces[i].mIndices[0];
@@ -74,11 +159,7 @@ void Model::ProcessMesh(aiMesh* mesh, const aiScene* scene) {
         indices[3*i+2] = mesh->mFaces[i].mIndices[2];
     }
 
-    auto glMesh = Mesh::Create(vertices, indices, GL_TRIANGLES);
-    if (mesh->mMaterialIndex >= 0)
-        glMesh->SetMaterial(m_materials[mesh->mMaterialIndex]);
-    
-    m_meshes.push_back(std::move(glMesh));
+    data.meshes.push_back(std::move(meshData));
 }
 
 void Model::Draw(const Program* program) const {
@@ -2,16 +2,33 @@
 #define __MODEL_H__
 
 #include "common.h"
+#include "image.h"
 #include "mesh.h"
 
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 
+// GL 리소스를 만들기 전 단계의 모델 데이터
+// 파일 파싱과 이미지 디코딩만 하므로 워커 스레드에서 만들 수 있음
+struct ModelMaterialData {
+    ImagePtr diffuse;
+    ImagePtr specular;
+    float shininess { 32.0f };
+};
+
+struct ModelData {
+    std::vector<MeshData> meshes;
+    std::vector<ModelMaterialData> materials;
+};
+
 CLASS_PTR(Model);
 class Model {
 public:
     static ModelUPtr Load(const std::string& filename);
+    static std::unique_ptr<ModelData> LoadData(const std::string& filename);
+    static ModelUPtr CreateFromData(ModelData& data);
+    static ModelUPtr CreateFromMeshes(std::vector<MeshPtr> meshes, std::vector<MaterialPtr> materials);
 
     int GetMeshCount() const { return (int)m_meshes.size(); }
     MeshPtr GetMesh(int index) const { return m_meshes[index]; }
@@ -19,10 +36,11 @@ public:
 
 private:
     Model() {}
-    bool LoadByAssimp(const std::string& filename);
-    void ProcessMesh(aiMesh* mesh, const aiScene* scene);
-    void ProcessNode(aiNode* node, const aiScene* scene);
-        
+    static bool LoadByObjParser(const std::string& filename, ModelData& data);
+    static bool LoadByAssimp(const std::string& filename, ModelData& data);
+    static void ProcessMesh(aiMesh* mesh, const aiScene* scene, ModelData& data);
+    static void ProcessNode(aiNode* node, const aiScene* scene, ModelData& data);
+
     std::vector<MeshPtr> m_meshes;
     std::vector<MaterialPtr> m_materials;
 };
@@ -0,0 +1,174 @@
+#include "model_loader.h"
+
+ModelLoaderUPtr ModelLoader::Start(const std::string& filename, const std::string& textureFilename,
+    bool optimizeMeshes) {
+    auto loader = ModelLoaderUPtr(new ModelLoader());
+    loader->m_filename = filename;
+    loader->m_textureFilename = textureFilename;
+    loader->m_optimizeMeshes = optimizeMeshes;
+    loader->m_worker = std::thread(&ModelLoader::Run, loader.get());
+    return std::move(loader);
+}
+
+ModelLoader::~ModelLoader() {
+    m_cancel = true;
+    if (m_worker.joinable())
+        m_worker.join();
+}
+
+// 워커 스레드
+void ModelLoader::Run() {
+    m_workerProgress = 0.05f;
+    auto data = Model::LoadData(m_filename);
+    m_workerProgress = 0.4f;
+
+    if (data && !m_cancel) {
+        if (!m_textureFilename.empty())
+            m_textureImage = Image::Load(m_textureFilename, false);
+        m_workerProgress = 0.45f;
+
+        for (auto& mesh : data->meshes) {
+            if (m_cancel || !m_optimizeMeshes)
+                break;
+            Mesh::Optimize(mesh.vertices, mesh.indices);
+        }
+    }
+    m_data = std::move(data);
+    m_workerProgress = 0.5f;
+    m_workerDone = true;
+}
+
+ModelLoader::State ModelLoader::Update(size_t uploadBudget) {
+    if (m_state == State::Done || m_state == State::Failed || m_state == State::Cancelled)
+        return m_state;
+
+    if (m_state == State::Loading) {
+        if (!m_workerDone)
+            return m_state;
+        m_worker.join();
+
+        if (m_cancel) {
+            m_state = State::Cancelled;
+            return m_state;
+        }
+        if (!m_data) {
+            m_state = State::Failed;
+            return m_state;
+        }
+        PrepareUploads();
+        m_state = State::Uploading;
+    }
+
+    if (m_cancel) {
+        m_uploads.clear();
+        m_meshes.clear();
+        m_materials.clear();
+        m_texture.reset();
+        m_data.reset();
+        m_state = State::Cancelled;
+        return m_state;
+    }
+
+    size_t spent = 0;
+    while (m_uploadIndex < m_uploads.size() && spent < uploadBudget) {
+        auto& item = m_uploads[m_uploadIndex];
+        if (item.buffer) {
+            size_t size = std::min(item.size - m_uploadOffset, uploadBudget - spent);
+            if (size > 0)
+                item.buffer->SetSubData(m_uploadOffset, item.data + m_uploadOffset, size);
+            m_uploadOffset += size;
+            spent += size;
+            if (m_uploadOffset < item.size)
+                continue;
+        }
+        else {
+            // 텍스쳐는 줄 단위로 나눠서 업로드, 최소 한 줄은 올림
+            int height = item.image->GetHeight();
+            size_t rowBytes = (size_t)item.image->GetWidth() * item.image->GetChannelCount();
+            int rows = (int)std::max<size_t>(1, (uploadBudget - spent) / std::max<size_t>(rowBytes, 1));
+            rows = std::min(rows, height - (int)m_uploadOffset);
+            item.texture->SetSubImage(item.image, (int)m_uploadOffset, rows);
+            m_uploadOffset += rows;
+            spent += rows * rowBytes;
+            if ((int)m_uploadOffset < height)
+                continue;
+            item.texture->GenerateMipmap();
+        }
+        m_uploadIndex++;
+        m_uploadOffset = 0;
+    }
+    m_uploadedBytes += spent;
+
+    if (m_uploadIndex < m_uploads.size())
+        return m_state;
+
+    m_model = Model::CreateFromMeshes(std::move(m_meshes), std::move(m_materials));
+    m_uploads.clear();
+    m_data.reset();
+    m_textureImage.reset();
+    m_state = State::Done;
+    return m_state;
+}
+
+// GL 오브젝트는 한번에 만들고 (메모리 할당만), 실제 데이터는 Update에서 나눠서 올림
+void ModelLoader::PrepareUploads() {
+    auto AddTexture = [&](const Image* image) -> TexturePtr {
+        TexturePtr texture = Texture::CreateForImage(image);
+        UploadItem item;
+        item.texture = texture;
+        item.image = image;
+        m_uploads.push_back(item);
+        m_totalBytes += (size_t)image->GetWidth() * image->GetHeight() * image->GetChannelCount();
+        return texture;
+    };
+    auto AddBuffer = [&](BufferPtr buffer, const void* data, size_t size) {
+        UploadItem item;
+        item.buffer = buffer;
+        item.data = (const uint8_t*)data;
+        item.size = size;
+        m_uploads.push_back(item);
+        m_totalBytes += size;
+    };
+
+    for (auto& material : m_data->materials) {
+        auto glMaterial = Material::Create();
+        if (material.diffuse)
+            glMaterial->diffuse = AddTexture(material.diffuse.get());
+        if (material.specular)
+            glMaterial->specular = AddTexture(material.specular.get());
+        glMaterial->shininess = material.shininess;
+        m_materials.push_back(std::move(glMaterial));
+    }
+
+    for (auto& mesh : m_data->meshes) {
+        MeshPtr glMesh = Mesh::CreateEmpty(mesh.vertices.size(), mesh.indices.size(), GL_TRIANGLES);
+        if (mesh.materialIndex >= 0 && mesh.materialIndex < (int)m_materials.size())
+            glMesh->SetMaterial(m_materials[mesh.materialIndex]);
+        AddBuffer(glMesh->GetVertexBuffer(), mesh.vertices.data(), mesh.vertices.size() * sizeof(Vertex));
+        AddBuffer(glMesh->GetIndexBuffer(), mesh.indices.data(), mesh.indices.size() * sizeof(uint32_t));
+        m_meshes.push_back(std::move(glMesh));
+    }
+
+    if (m_textureImage)
+        m_texture = AddTexture(m_textureImage.get());
+}
+
+float ModelLoader::GetProgress() const {
+    if (m_state == State::Loading)
+        return m_workerProgress;
+    if (m_state == State::Uploading && m_totalBytes > 0)
+        return 0.5f + 0.5f * (float)m_uploadedBytes / (float)m_totalBytes;
+    return 1.0f;
+}
+
+const char* ModelLoader::GetStatus() const {
+    if (m_cancel)
+        return "cancelling";
+    switch (m_state) {
+        case State::Loading: return "parsing";
+        case State::Uploading: return "uploading";
+        case State::Done: return "done";
+        case State::Failed: return "failed";
+        default: return "cancelled";
+    }
+}
\ No newline at end of file
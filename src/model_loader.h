@@ -0,0 +1,75 @@
+#ifndef __MODEL_LOADER_H__
+#define __MODEL_LOADER_H__
+
+#include "common.h"
+#include "model.h"
+#include <atomic>
+#include <thread>
+
+/*
+모델 비동기 로딩
+1. 워커 스레드 : 파일 파싱, 이미지 디코딩, mesh 최적화 (GL 호출 없음)
+2. 렌더 스레드 : 매 프레임 Update()에서 정해진 바이트만큼만 버퍼/텍스쳐 업로드
+*/
+CLASS_PTR(ModelLoader)
+class ModelLoader {
+public:
+    enum class State { Loading, Uploading, Done, Failed, Cancelled };
+    static const size_t DEFAULT_UPLOAD_BUDGET = 4 << 20;
+
+    // textureFilename이 비어있으면 텍스쳐 없이 모델만 로딩
+    // optimizeMeshes가 꺼져 있으면 워커에서 Mesh::Optimize를 건너뜀
+    static ModelLoaderUPtr Start(const std::string& filename, const std::string& textureFilename,
+        bool optimizeMeshes = true);
+    ~ModelLoader();
+
+    State Update(size_t uploadBudget = DEFAULT_UPLOAD_BUDGET);
+    void Cancel() { m_cancel = true; }
+
+    State GetState() const { return m_state; }
+    float GetProgress() const;
+    const char* GetStatus() const;
+    const std::string& GetFilename() const { return m_filename; }
+
+    ModelUPtr TakeModel() { return std::move(m_model); }
+    TexturePtr TakeTexture() { return std::move(m_texture); }
+
+private:
+    ModelLoader() {}
+    void Run();
+    void PrepareUploads();
+
+    // 버퍼 업로드는 buffer, 텍스쳐 업로드는 texture가 채워짐
+    struct UploadItem {
+        BufferPtr buffer;
+        const uint8_t* data { nullptr };
+        size_t size { 0 };
+        TexturePtr texture;
+        const Image* image { nullptr };
+    };
+
+    std::string m_filename;
+    std::string m_textureFilename;
+    bool m_optimizeMeshes { true };
+    State m_state { State::Loading };
+
+    std::thread m_worker;
+    std::atomic<bool> m_workerDone { false };
+    std::atomic<bool> m_cancel { false };
+    std::atomic<float> m_workerProgress { 0.0f };
+    std::unique_ptr<ModelData> m_data;
+    ImageUPtr m_textureImage;
+
+    std::vector<UploadItem> m_uploads;
+    size_t m_uploadIndex { 0 };
+    size_t m_uploadOffset { 0 };
+    size_t m_uploadedBytes { 0 };
+    size_t m_totalBytes { 0 };
+    std::vector<MeshPtr> m_meshes;
+    std::vector<MaterialPtr> m_materials;
+
+    ModelUPtr m_model;
+    TexturePtr m_texture;
+};
+
+#endif // __MODEL_LOADER_H__
\ No newline at end of file
@@ -0,0 +1,460 @@
+#include "obj_parser.h"
+#include "mapped_file.h"
+#include <atomic>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+
+// OBJ의 인덱스는 1부터 시작, 0은 해당 attribute가 없다는 의미로 사용
+struct ObjCorner {
+    uint32_t v;
+    uint32_t vt;
+    uint32_t vn;
+
+    bool operator==(const ObjCorner& other) const {
+        return v == other.v && vt == other.vt && vn == other.vn;
+    }
+};
+
+struct ObjCornerHash {
+    size_t operator()(const ObjCorner& corner) const {
+        uint64_t key = ((uint64_t)corner.v * 0x9E3779B97F4A7C15ull) ^
+            ((uint64_t)corner.vt * 0xC2B2AE3D27D4EB4Full) ^ corner.vn;
+        return (size_t)(key ^ (key >> 32));
+    }
+};
+
+// o, g, usemtl 이 등장한 위치 (청크 안에서의 corner 번호)
+struct ObjEvent {
+    size_t corner;
+    bool isMaterial;
+    std::string name;
+};
+
+struct ObjChunk {
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec2> texCoords;
+    std::vector<glm::vec3> normals;
+    std::vector<ObjCorner> corners;
+    std::vector<ObjEvent> events;
+    std::vector<std::string> materialLibraries;
+    std::string unsupported; // 지원하지 않는 구문이 있으면 그 줄의 키워드
+};
+
+struct ObjSegment {
+    std::string name;
+    std::string material;
+    size_t begin;
+    size_t end;
+};
+
+const size_t MIN_CHUNK_SIZE = 1 << 20;
+const size_t PARALLEL_GRAIN = 1 << 16;
+
+bool IsSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+void SkipSpace(std::string_view& s) {
+    size_t i = 0;
+    while (i < s.size() && IsSpace(s[i]))
+        i++;
+    s.remove_prefix(i);
+}
+
+std::string_view Trim(std::string_view s) {
+    SkipSpace(s);
+    while (!s.empty() && IsSpace(s.back()))
+        s.remove_suffix(1);
+    return s;
+}
+
+bool ParseFloat(std::string_view& s, float& value) {
+    SkipSpace(s);
+    if (!s.empty() && s[0] == '+')
+        s.remove_prefix(1);
+    auto result = std::from_chars(s.data(), s.data() + s.size(), value);
+    if (result.ec != std::errc())
+        return false;
+    s.remove_prefix(result.ptr - s.data());
+    return true;
+}
+
+// 음수(상대) 인덱스는 청크끼리 독립적으로 처리할 수 없으므로 지원하지 않음
+bool ParseIndex(std::string_view& s, uint32_t& value) {
+    auto result = std::from_chars(s.data(), s.data() + s.size(), value);
+    if (result.ec != std::errc() || value == 0)
+        return false;
+    s.remove_prefix(result.ptr - s.data());
+    return true;
+}
+
+bool ParseFace(std::string_view s, std::vector<ObjCorner>& polygon, std::vector<ObjCorner>& corners) {
+    polygon.clear();
+    while (true) {
+        SkipSpace(s);
+        if (s.empty())
+            break;
+
+        ObjCorner corner { 0, 0, 0 };
+        if (!ParseIndex(s, corner.v))
+            return false;
+        if (!s.empty() && s[0] == '/') {
+            s.remove_prefix(1);
+            if (!s.empty() && s[0] != '/' && !ParseIndex(s, corner.vt))
+                return false;
+            if (!s.empty() && s[0] == '/') {
+                s.remove_prefix(1);
+                if (!ParseIndex(s, corner.vn))
+                    return false;
+            }
+        }
+        if (!s.empty() && !IsSpace(s[0]))
+            return false;
+        polygon.push_back(corner);
+    }
+    if (polygon.size() < 3)
+        return false;
+
+    // 다각형은 fan 형태로 삼각형 분할
+    for (size_t i = 1; i + 1 < polygon.size(); i++) {
+        corners.push_back(polygon[0]);
+        corners.push_back(polygon[i]);
+        corners.push_back(polygon[i + 1]);
+    }
+    return true;
+}
+
+bool ParseLine(std::string_view line, ObjChunk& chunk, std::vector<ObjCorner>& polygon) {
+    SkipSpace(line);
+    if (line.empty() || line[0] == '#')
+        return true;
+
+    size_t keywordLength = 0;
+    while (keywordLength < line.size() && !IsSpace(line[keywordLength]))
+        keywordLength++;
+    std::string_view keyword = line.substr(0, keywordLength);
+    std::string_view rest = line.substr(keywordLength);
+
+    if (keyword == "v") {
+        glm::vec3 position;
+        if (!ParseFloat(rest, position.x) || !ParseFloat(rest, position.y) || !ParseFloat(rest, position.z))
+            return false;
+        chunk.positions.push_back(position);
+    }
+    else if (keyword == "vt") {
+        glm::vec2 texCoord(0.0f);
+        if (!ParseFloat(rest, texCoord.x))
+            return false;
+        ParseFloat(rest, texCoord.y);
+        chunk.texCoords.push_back(texCoord);
+    }
+    else if (keyword == "vn") {
+        glm::vec3 normal;
+        if (!ParseFloat(rest, normal.x) || !ParseFloat(rest, normal.y) || !ParseFloat(rest, normal.z))
+            return false;
+        chunk.normals.push_back(normal);
+    }
+    else if (keyword == "f") {
+        if (!ParseFace(rest, polygon, chunk.corners))
+            return false;
+    }
+    else if (keyword == "o" || keyword == "g") {
+        chunk.events.push_back({ chunk.corners.size(), false, std::string(Trim(rest)) });
+    }
+    else if (keyword == "usemtl") {
+        chunk.events.push_back({ chunk.corners.size(), true, std::string(Trim(rest)) });
+    }
+    else if (keyword == "mtllib") {
+        chunk.materialLibraries.push_back(std::string(Trim(rest)));
+    }
+    else if (keyword != "s") {
+        // l, p, vp, curv, surf ... 등은 Assimp에 맡김
+        return false;
+    }
+    return true;
+}
+
+void ParseChunk(const char* begin, const char* end, ObjChunk& chunk) {
+    std::vector<ObjCorner> polygon;
+    const char* p = begin;
+    while (p < end) {
+        auto lineEnd = (const char*)memchr(p, '\n', end - p);
+        if (!lineEnd)
+            lineEnd = end;
+        std::string_view line(p, lineEnd - p);
+        p = lineEnd + 1;
+
+        if (!ParseLine(line, chunk, polygon)) {
+            chunk.unsupported = std::string(Trim(line).substr(0, 32));
+            return;
+        }
+    }
+}
+
+// 합쳐진 배열에서 corner 하나를 Vertex로 변환
+// Assimp의 aiProcess_FlipUVs와 같은 결과가 나오도록 v 좌표를 뒤집음
+Vertex MakeVertex(const ObjCorner& corner, const std::vector<glm::vec3>& positions,
+    const std::vector<glm::vec2>& texCoords, const std::vector<glm::vec3>& normals) {
+    Vertex vertex {};
+    vertex.position = positions[corner.v - 1];
+    if (corner.vt) {
+        auto& texCoord = texCoords[corner.vt - 1];
+        vertex.texCoord = glm::vec2(texCoord.x, 1.0f - texCoord.y);
+    }
+    if (corner.vn)
+        vertex.normal = normals[corner.vn - 1];
+    return vertex;
+}
+
+void BuildMesh(const std::vector<glm::vec3>& positions, const std::vector<glm::vec2>& texCoords,
+    const std::vector<glm::vec3>& normals, const std::vector<ObjCorner>& corners,
+    size_t begin, size_t end, MeshData& mesh) {
+
+    // v, vt, vn 인덱스가 모두 같으면 (이 프로그램이 export한 파일) 해시맵 없이
+    // 위치 인덱스 범위를 그대로 vertex 배열로 쓰고 인덱스만 병렬로 옮김
+    std::mutex mutex;
+    uint32_t minIndex = UINT32_MAX;
+    uint32_t maxIndex = 0;
+    bool aligned = true;
+    size_t texCount = 0;
+    size_t normalCount = 0;
+    ParallelFor(end - begin, PARALLEL_GRAIN, [&](size_t rangeBegin, size_t rangeEnd) {
+        uint32_t localMin = UINT32_MAX;
+        uint32_t localMax = 0;
+        bool localAligned = true;
+        size_t localTex = 0;
+        size_t localNormal = 0;
+        for (size_t i = begin + rangeBegin; i < begin + rangeEnd; i++) {
+            auto& corner = corners[i];
+            localMin = std::min(localMin, corner.v);
+            localMax = std::max(localMax, corner.v);
+            localAligned &= (corner.vt == 0 || corner.vt == corner.v) && (corner.vn == 0 || corner.vn == corner.v);
+            localTex += corner.vt ? 1 : 0;
+            localNormal += corner.vn ? 1 : 0;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        minIndex = std::min(minIndex, localMin);
+        maxIndex = std::max(maxIndex, localMax);
+        aligned &= localAligned;
+        texCount += localTex;
+        normalCount += localNormal;
+    });
+
+    size_t cornerCount = end - begin;
+    aligned &= (texCount == 0 || texCount == cornerCount) && (normalCount == 0 || normalCount == cornerCount);
+
+    if (aligned) {
+        bool hasTexCoord = texCount > 0;
+        bool hasNormal = normalCount > 0;
+        mesh.vertices.resize(maxIndex - minIndex + 1);
+        ParallelFor(mesh.vertices.size(), PARALLEL_GRAIN, [&](size_t rangeBegin, size_t rangeEnd) {
+            for (size_t i = rangeBegin; i < rangeEnd; i++) {
+                uint32_t index = minIndex + (uint32_t)i;
+                mesh.vertices[i] = MakeVertex({ index, hasTexCoord ? index : 0, hasNormal ? index : 0 },
+                    positions, texCoords, normals);
+            }
+        });
+
+        mesh.indices.resize(cornerCount);
+        ParallelFor(cornerCount, PARALLEL_GRAIN, [&](size_t rangeBegin, size_t rangeEnd) {
+            for (size_t i = rangeBegin; i < rangeEnd; i++)
+                mesh.indices[i] = corners[begin + i].v - minIndex;
+        });
+        return;
+    }
+
+    // 인덱스 조합이 제각각인 일반적인 OBJ는 (v, vt, vn) 조합마다 vertex 하나씩 생성
+    std::unordered_map<ObjCorner, uint32_t, ObjCornerHash> vertexMap;
+    vertexMap.reserve(cornerCount);
+    mesh.indices.reserve(cornerCount);
+    for (size_t i = begin; i < end; i++) {
+        auto result = vertexMap.emplace(corners[i], (uint32_t)mesh.vertices.size());
+        if (result.second)
+            mesh.vertices.push_back(MakeVertex(corners[i], positions, texCoords, normals));
+        mesh.indices.push_back(result.first->second);
+    }
+}
+
+} // namespace
+
+ObjParserUPtr ObjParser::Parse(const std::string& filename) {
+    auto parser = ObjParserUPtr(new ObjParser());
+    if (!parser->ParseFile(filename))
+        return nullptr;
+    return std::move(parser);
+}
+
+bool ObjParser::ParseFile(const std::string& filename) {
+    auto file = MappedFile::Open(filename);
+    if (!file)
+        return false;
+    const char* data = file->GetData();
+    size_t size = file->GetSize();
+
+    // 줄 경계에서 청크를 나눔
+    size_t threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+    size_t chunkCount = std::max<size_t>(1, std::min(threadCount, size / MIN_CHUNK_SIZE));
+    std::vector<size_t> bounds { 0 };
+    for (size_t i = 1; i < chunkCount; i++) {
+        size_t pos = std::max(bounds.back(), size * i / chunkCount);
+        auto newline = (const char*)memchr(data + pos, '\n', size - pos);
+        pos = newline ? (size_t)(newline - data) + 1 : size;
+        if (pos > bounds.back() && pos < size)
+            bounds.push_back(pos);
+    }
+    bounds.push_back(size);
+    chunkCount = bounds.size() - 1;
+
+    std::vector<ObjChunk> chunks(chunkCount);
+    ParallelFor(chunkCount, 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+            ParseChunk(data + bounds[i], data + bounds[i + 1], chunks[i]);
+    });
+
+    for (auto& chunk : chunks) {
+        if (!chunk.unsupported.empty()) {
+            SPDLOG_INFO("obj parser does not support \"{}\": {}", chunk.unsupported, filename);
+            return false;
+        }
+    }
+
+    // 청크별 결과를 앞에서부터 이어붙일 위치 계산
+    std::vector<size_t> positionOffset(chunkCount + 1, 0);
+    std::vector<size_t> texCoordOffset(chunkCount + 1, 0);
+    std::vector<size_t> normalOffset(chunkCount + 1, 0);
+    std::vector<size_t> cornerOffset(chunkCount + 1, 0);
+    for (size_t i = 0; i < chunkCount; i++) {
+        positionOffset[i + 1] = positionOffset[i] + chunks[i].positions.size();
+        texCoordOffset[i + 1] = texCoordOffset[i] + chunks[i].texCoords.size();
+        normalOffset[i + 1] = normalOffset[i] + chunks[i].normals.size();
+        cornerOffset[i + 1] = cornerOffset[i] + chunks[i].corners.size();
+    }
+
+    std::vector<glm::vec3> positions(positionOffset[chunkCount]);
+    std::vector<glm::vec2> texCoords(texCoordOffset[chunkCount]);
+    std::vector<glm::vec3> normals(normalOffset[chunkCount]);
+    std::vector<ObjCorner> corners(cornerOffset[chunkCount]);
+    ParallelFor(chunkCount, 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            auto& chunk = chunks[i];
+            std::copy(chunk.positions.begin(), chunk.positions.end(), positions.begin() + positionOffset[i]);
+            std::copy(chunk.texCoords.begin(), chunk.texCoords.end(), texCoords.begin() + texCoordOffset[i]);
+            std::copy(chunk.normals.begin(), chunk.normals.end(), normals.begin() + normalOffset[i]);
+            std::copy(chunk.corners.begin(), chunk.corners.end(), corners.begin() + cornerOffset[i]);
+            chunk.positions = {};
+            chunk.texCoords = {};
+            chunk.normals = {};
+            chunk.corners = {};
+        }
+    });
+
+    std::atomic<bool> invalid { false };
+    ParallelFor(corners.size(), PARALLEL_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            auto& corner = corners[i];
+            if (corner.v > positions.size() || corner.vt > texCoords.size() || corner.vn > normals.size()) {
+                invalid = true;
+                return;
+            }
+        }
+    });
+    if (invalid) {
+        SPDLOG_ERROR("face index out of range: {}", filename);
+        return false;
+    }
+    // 면이 없으면 빈 모델이 되므로 Assimp가 대신 읽도록 실패로 처리
+    if (corners.empty()) {
+        SPDLOG_INFO("obj parser found no faces: {}", filename);
+        return false;
+    }
+
+    auto dirname = filename.substr(0, filename.find_last_of("/\\") + 1);
+    for (auto& chunk : chunks) {
+        for (auto& library : chunk.materialLibraries)
+            LoadMaterialLibrary(dirname + library);
+    }
+
+    // o, g, usemtl 을 기준으로 mesh 구간 나누기
+    std::vector<ObjSegment> segments;
+    std::string name;
+    std::string material;
+    size_t start = 0;
+    for (size_t i = 0; i < chunkCount; i++) {
+        for (auto& event : chunks[i].events) {
+            size_t corner = cornerOffset[i] + event.corner;
+            if (corner > start) {
+                segments.push_back({ name, material, start, corner });
+                start = corner;
+            }
+            if (event.isMaterial)
+                material = event.name;
+            else
+                name = event.name;
+        }
+    }
+    if (corners.size() > start)
+        segments.push_back({ name, material, start, corners.size() });
+
+    m_meshes.resize(segments.size());
+    for (size_t i = 0; i < segments.size(); i++) {
+        auto& segment = segments[i];
+        auto& mesh = m_meshes[i];
+        mesh.name = segment.name;
+        mesh.materialIndex = FindMaterial(segment.material);
+        BuildMesh(positions, texCoords, normals, corners, segment.begin, segment.end, mesh);
+    }
+
+    return true;
+}
+
+void ObjParser::LoadMaterialLibrary(const std::string& filename) {
+    std::ifstream fin(filename);
+    if (!fin.is_open()) {
+        SPDLOG_WARN("failed to open material library: {}", filename);
+        return;
+    }
+
+    // 텍스쳐 경로 앞의 옵션 (-bm 1.0 등)은 무시하고 마지막 토큰만 사용
+    auto MapPath = [](std::string_view rest) -> std::string {
+        rest = Trim(rest);
+        if (!rest.empty() && rest[0] == '-') {
+            size_t pos = rest.find_last_of(" \t");
+            if (pos != std::string_view::npos)
+                rest = rest.substr(pos + 1);
+        }
+        return std::string(rest);
+    };
+
+    std::string line;
+    while (std::getline(fin, line)) {
+        std::string_view view = line;
+        SkipSpace(view);
+        size_t keywordLength = 0;
+        while (keywordLength < view.size() && !IsSpace(view[keywordLength]))
+            keywordLength++;
+        std::string_view keyword = view.substr(0, keywordLength);
+        std::string_view rest = view.substr(keywordLength);
+
+        if (keyword == "newmtl")
+            m_materials.push_back({ std::string(Trim(rest)), "", "" });
+        else if (keyword == "map_Kd" && !m_materials.empty())
+            m_materials.back().diffuseMap = MapPath(rest);
+        else if (keyword == "map_Ks" && !m_materials.empty())
+            m_materials.back().specularMap = MapPath(rest);
+    }
+}
+
+int ObjParser::FindMaterial(const std::string& name) const {
+    for (size_t i = 0; i < m_materials.size(); i++) {
+        if (m_materials[i].name == name)
+            return (int)i;
+    }
+    return -1;
+}
@@ -0,0 +1,41 @@
+#ifndef __OBJ_PARSER_H__
+#define __OBJ_PARSER_H__
+
+#include "core_common.h"
+#include "mesh_data.h"
+#include <vector>
+
+/*
+삼각형/다각형 면과 v, vt, vn, o, g, usemtl, mtllib 만 사용하는 OBJ 전용 파서
+파일을 메모리 매핑한 뒤 줄 단위로 청크를 나눠 병렬로 파싱하고,
+청크별 결과를 하나로 합치면서 인덱스를 병렬로 재배치
+
+음수(상대) 인덱스나 선/곡면처럼 지원하지 않는 구문을 만나거나 면이 하나도 없으면 실패를 반환하므로
+호출하는 쪽에서 Assimp로 다시 읽으면 됨
+*/
+struct ObjMaterialInfo {
+    std::string name;
+    std::string diffuseMap;
+    std::string specularMap;
+};
+
+CLASS_PTR(ObjParser)
+class ObjParser {
+public:
+    static ObjParserUPtr Parse(const std::string& filename);
+
+    const std::vector<MeshData>& GetMeshes() const { return m_meshes; }
+    std::vector<MeshData>& GetMeshes() { return m_meshes; }
+    const std::vector<ObjMaterialInfo>& GetMaterials() const { return m_materials; }
+
+private:
+    ObjParser() {}
+    bool ParseFile(const std::string& filename);
+    void LoadMaterialLibrary(const std::string& filename);
+    int FindMaterial(const std::string& name) const;
+
+    std::vector<MeshData> m_meshes;
+    std::vector<ObjMaterialInfo> m_materials;
+};
+
+#endif // __OBJ_PARSER_H__
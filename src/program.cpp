@@ -1,5 +1,61 @@
 #include "common.h"
 #include "program.h"
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+const char BINARY_MAGIC[4] = { 'T', 'G', 'P', 'B' };
+const uint32_t BINARY_VERSION = 1;
+
+struct ProgramBinaryHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t format;
+    uint32_t size;
+    uint64_t checksum;
+};
+
+std::string s_binaryCacheDirectory;
+
+// 캐시를 사용할 수 없으면 빈 문자열
+std::string GetBinaryCachePath(const std::string& vertCode, const std::string& fragCode) {
+    if (s_binaryCacheDirectory.empty())
+        return "";
+    // GL 4.1 또는 ARB_get_program_binary가 없으면 사용 안 함
+    static GLint formatCount = -1;
+    if (formatCount < 0) {
+        GLint count = 0;
+        if (glGetProgramBinary && glProgramBinary)
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &count);
+        formatCount = count;
+    }
+    if (formatCount <= 0)
+        return "";
+
+    // 드라이버가 바뀌면 바이너리를 쓸 수 없으므로 키에 포함
+    auto GetString = [](GLenum name) -> std::string {
+        auto value = (const char*)glGetString(name);
+        return value ? value : "";
+    };
+    std::string key = vertCode + '\0' + fragCode + '\0' + GetString(GL_VENDOR) + '\0' +
+        GetString(GL_RENDERER) + '\0' + GetString(GL_VERSION);
+    return fmt::format("{}/{:016x}.bin", s_binaryCacheDirectory, HashBytes(key.data(), key.size()));
+}
+
+} // namespace
+
+void Program::SetBinaryCacheDirectory(const std::string& directory) {
+    s_binaryCacheDirectory = directory;
+    if (directory.empty())
+        return;
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        SPDLOG_ERROR("failed to create program cache directory: {}", directory);
+        s_binaryCacheDirectory.clear();
+    }
+}
 
 ProgramUPtr Program::Create(const std::vector<ShaderPtr>& shaders){
     auto program = ProgramUPtr(new Program());
@@ -11,15 +67,95 @@ ProgramUPtr Program::Create(const std::vector<ShaderPtr>& shaders){
 
 ProgramUPtr Program::Create(const std::string& vertShaderFilename,
     const std::string& fragShaderFilename) {
-    ShaderPtr vs = Shader::CreateFromFile(vertShaderFilename, GL_VERTEX_SHADER);
-    ShaderPtr fs = Shader::CreateFromFile(fragShaderFilename, GL_FRAGMENT_SHADER);
+    auto vertCode = LoadTextFile(vertShaderFilename);
+    auto fragCode = LoadTextFile(fragShaderFilename);
+    if (!vertCode || !fragCode)
+        return nullptr;
+
+    std::string cachePath = GetBinaryCachePath(*vertCode, *fragCode);
+    if (!cachePath.empty()) {
+        auto program = ProgramUPtr(new Program());
+        if (program->LoadBinary(cachePath))
+            return std::move(program);
+    }
+
+    ShaderPtr vs = Shader::CreateFromSource(*vertCode, GL_VERTEX_SHADER, vertShaderFilename);
+    ShaderPtr fs = Shader::CreateFromSource(*fragCode, GL_FRAGMENT_SHADER, fragShaderFilename);
     if (!vs || !fs)
         return nullptr;
-    return std::move(Create({vs, fs}));
+    auto program = ProgramUPtr(new Program());
+    if (!program->Link({vs, fs}, !cachePath.empty()))
+        return nullptr;
+    if (!cachePath.empty())
+        program->SaveBinary(cachePath);
+    return std::move(program);
 }
 
-bool Program::Link(const std::vector<ShaderPtr>& shaders){
+// 드라이버가 거부하면 (업데이트 등) 파일을 지우고 false, 호출한 쪽에서 소스로 컴파일
+bool Program::LoadBinary(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open())
+        return false;
+    ProgramBinaryHeader header;
+    std::vector<char> binary;
+    bool valid = in.read((char*)&header, sizeof(header)) &&
+        memcmp(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0 &&
+        header.version == BINARY_VERSION && header.size > 0;
+    if (valid) {
+        binary.resize(header.size);
+        valid = in.read(binary.data(), binary.size()) &&
+            HashBytes(binary.data(), binary.size()) == header.checksum;
+    }
+    in.close();
+
+    int success = 0;
+    if (valid) {
+        m_program = glCreateProgram();
+        glProgramBinary(m_program, header.format, binary.data(), (GLsizei)binary.size());
+        glGetProgramiv(m_program, GL_LINK_STATUS, &success);
+    }
+    if (!success) {
+        SPDLOG_INFO("program binary is invalid, compiling from source: {}", path);
+        if (m_program) {
+            glDeleteProgram(m_program);
+            m_program = 0;
+        }
+        std::error_code error;
+        std::filesystem::remove(path, error);
+        return false;
+    }
+    QueryAttribs();
+    return true;
+}
+
+void Program::SaveBinary(const std::string& path) const {
+    GLint length = 0;
+    glGetProgramiv(m_program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return;
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    glGetProgramBinary(m_program, length, &length, &format, binary.data());
+    binary.resize(length);
+
+    ProgramBinaryHeader header;
+    memcpy(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    header.version = BINARY_VERSION;
+    header.format = format;
+    header.size = (uint32_t)binary.size();
+    header.checksum = HashBytes(binary.data(), binary.size());
+
+    // 쓰는 도중에 종료되어도 잘못된 파일이 남지 않도록 임시 파일에 쓰고 이름 변경
+    if (!WriteFileAtomic(path, { std::string_view((const char*)&header, sizeof(header)),
+            std::string_view(binary.data(), binary.size()) }))
+        SPDLOG_ERROR("failed to write program binary: {}", path);
+}
+
+bool Program::Link(const std::vector<ShaderPtr>& shaders, bool retrievable){
     m_program = glCreateProgram();
+    // 바이너리를 저장할 프로그램은 링크 전에 알려줘야 함
+    if(retrievable)
+        glProgramParameteri(m_program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     for(auto& shader: shaders)
         glAttachShader(m_program, shader->Get());
     glLinkProgram(m_program);
@@ -32,9 +168,26 @@ bool Program::Link(const std::vector<ShaderPtr>& shaders){
         SPDLOG_ERROR("failed to link program: {}",infoLog);
         return false;
     }
+    QueryAttribs();
     return true;
 }
 
+// 링크된 프로그램이 실제로 읽는 attribute location 기록 (Mesh::Draw에서 vertex 형식 확인용)
+void Program::QueryAttribs() {
+    m_attribMask = 0;
+    GLint count = 0;
+    glGetProgramiv(m_program, GL_ACTIVE_ATTRIBUTES, &count);
+    for (GLint i = 0; i < count; i++) {
+        char name[256];
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveAttrib(m_program, i, sizeof(name), nullptr, &size, &type, name);
+        GLint location = glGetAttribLocation(m_program, name);
+        if (location >= 0 && location < 32)
+            m_attribMask |= 1u << location;
+    }
+}
+
 Program::~Program(){
     if(m_program){
         glDeleteProgram(m_program);
@@ -46,32 +199,37 @@ void Program::Use() const {
 }
 
 // program.cpp
-void Program::SetUniform(const std::string& name, int value) const {
-    auto loc = glGetUniformLocation(m_program, name.c_str());
+void Program::SetUniform(const char* name, int value) const {
+    auto loc = glGetUniformLocation(m_program, name);
     glUniform1i(loc, value);
 }
 
-void Program::SetUniform(const std::string& name, float value) const {
-    auto loc = glGetUniformLocation(m_program, name.c_str());
+void Program::SetUniform(const char* name, float value) const {
+    auto loc = glGetUniformLocation(m_program, name);
     glUniform1f(loc, value);
 }
 
-void Program::SetUniform(const std::string& name, const glm::vec2& value) const {
-    auto loc = glGetUniformLocation(m_program, name.c_str());
+void Program::SetUniform(const char* name, const glm::vec2& value) const {
+    auto loc = glGetUniformLocation(m_program, name);
     glUniform2fv(loc, 1, glm::value_ptr(value));
 }
 
-void Program::SetUniform(const std::string& name, const glm::vec3& value) const {
-    auto loc = glGetUniformLocation(m_program, name.c_str());
+void Program::SetUniform(const char* name, const glm::vec3& value) const {
+    auto loc = glGetUniformLocation(m_program, name);
     glUniform3fv(loc, 1, glm::value_ptr(value));
 }
 
-void Program::SetUniform(const std::string& name, const glm::vec4& value) const {
-    auto loc = glGetUniformLocation(m_program, name.c_str());
+void Program::SetUniform(const char* name, const glm::vec4& value) const {
+    auto loc = glGetUniformLocation(m_program, name);
     glUniform4fv(loc, 1, glm::value_ptr(value));
 }
 
-void Program::SetUniform(const std::string& name, const glm::mat4& value) const {
-    auto loc = glGetUniformLocation(m_program, name.c_str());
+void Program::SetUniform(const char* name, const glm::mat4& value) const {
+    auto loc = glGetUniformLocation(m_program, name);
     glUniformMatrix4fv(loc, 1, GL_FALSE, glm::value_ptr(value));
+}
+
+void Program::SetUniform(const char* name, Span<const glm::vec4> values) const {
+    auto loc = glGetUniformLocation(m_program, name);
+    glUniform4fv(loc, (GLsizei)values.size(), glm::value_ptr(values[0]));
 }
\ No newline at end of file
@@ -13,22 +13,35 @@ public:
     static ProgramUPtr Create(const std::string& vertShaderFilename,
         const std::string& fragShaderFilename);
 
+    // 설정하면 파일로 만든 프로그램의 바이너리를 저장해두고 다음부터는 컴파일 없이 불러옴
+    // 쉐이더 소스와 드라이버(vendor, renderer, version)가 같을 때만 사용 (빈 문자열이면 사용 안 함)
+    static void SetBinaryCacheDirectory(const std::string& directory);
+
     ~Program();
     uint32_t Get() const {return m_program;}
     void Use() const;
+    // vertex shader가 해당 location의 attribute를 사용하는지 (location 0 ~ 31)
+    bool IsAttribActive(uint32_t location) const { return location < 32 && ((m_attribMask >> location) & 1); }
 
     // ... in Program class declaration
-    void SetUniform(const std::string& name, int value) const;
-    void SetUniform(const std::string& name, float value) const;
-    void SetUniform(const std::string& name, const glm::vec2& value) const;
-    void SetUniform(const std::string& name, const glm::vec3& value) const;
-    void SetUniform(const std::string& name, const glm::vec4& value) const;
-    void SetUniform(const std::string& name, const glm::mat4& value) const;
+    // name은 문자열 상수를 그대로 넘김 (매 draw마다 std::string을 만들지 않도록)
+    void SetUniform(const char* name, int value) const;
+    void SetUniform(const char* name, float value) const;
+    void SetUniform(const char* name, const glm::vec2& value) const;
+    void SetUniform(const char* name, const glm::vec3& value) const;
+    void SetUniform(const char* name, const glm::vec4& value) const;
+    void SetUniform(const char* name, const glm::mat4& value) const;
+    // uniform 배열 (name은 배열 이름)
+    void SetUniform(const char* name, Span<const glm::vec4> values) const;
 
 private:
     Program() {}
-    bool Link(const std::vector<ShaderPtr>& shaders);
+    bool Link(const std::vector<ShaderPtr>& shaders, bool retrievable = false);
+    bool LoadBinary(const std::string& path);
+    void SaveBinary(const std::string& path) const;
+    void QueryAttribs();
     uint32_t m_program{0};
+    uint32_t m_attribMask{0};
 };
 
 #endif // __PROGRAM_H__
\ No newline at end of file
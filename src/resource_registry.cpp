@@ -0,0 +1,54 @@
+#include "resource_registry.h"
+#include <algorithm>
+#include <numeric>
+
+ResourceRegistryUPtr ResourceRegistry::Create() {
+    auto registry = ResourceRegistryUPtr(new ResourceRegistry());
+    registry->m_start = std::chrono::steady_clock::now();
+    return std::move(registry);
+}
+
+size_t ResourceRegistry::Register(const std::string& name) {
+    Entry entry;
+    entry.name = name;
+    m_entries.push_back(entry);
+    return m_entries.size() - 1;
+}
+
+void ResourceRegistry::Record(size_t index, bool success, double createMs) {
+    auto& entry = m_entries[index];
+    if (entry.createCount == 0) {
+        entry.firstUseMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - m_start).count() - createMs;
+    }
+    entry.createCount++;
+    entry.createMs += createMs;
+    entry.failed = !success;
+    if (!success)
+        SPDLOG_ERROR("failed to create resource: {}", entry.name);
+}
+
+void ResourceRegistry::LogTrace() const {
+    std::vector<size_t> order(m_entries.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return m_entries[a].firstUseMs < m_entries[b].firstUseMs;
+    });
+
+    size_t usedCount = 0;
+    double totalMs = 0.0;
+    std::string unused;
+    for (auto index : order) {
+        auto& entry = m_entries[index];
+        if (entry.createCount == 0) {
+            unused += unused.empty() ? entry.name : ", " + entry.name;
+            continue;
+        }
+        usedCount++;
+        totalMs += entry.createMs;
+        SPDLOG_INFO("resource {:<24} first use {:8.1f} ms, create {:6.1f} ms x{}{}", entry.name,
+            entry.firstUseMs, entry.createMs, entry.createCount, entry.failed ? " (failed)" : "");
+    }
+    SPDLOG_INFO("resources created: {} / {} ({:.1f} ms), not used: {}", usedCount, m_entries.size(),
+        totalMs, unused.empty() ? "-" : unused);
+}
\ No newline at end of file
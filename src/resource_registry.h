@@ -0,0 +1,82 @@
+#ifndef __RESOURCE_REGISTRY_H__
+#define __RESOURCE_REGISTRY_H__
+
+#include "common.h"
+#include <chrono>
+#include <functional>
+#include <vector>
+
+/*
+GPU 리소스 지연 생성
+1. LazyResource는 이름과 생성 함수만 들고 있다가 처음 Get할 때 만듦
+2. 만들 때마다 ResourceRegistry에 시작 후 시간과 생성에 걸린 시간을 기록
+3. 한번도 쓰지 않은 리소스는 만들지 않으므로 시작 시간과 VRAM에 포함되지 않음
+*/
+CLASS_PTR(ResourceRegistry)
+class ResourceRegistry {
+public:
+    struct Entry {
+        std::string name;
+        int createCount { 0 };
+        bool failed { false };
+        double firstUseMs { 0.0 }; // registry를 만든 후 처음 사용할 때까지
+        double createMs { 0.0 };   // 생성에 걸린 시간 합
+    };
+
+    static ResourceRegistryUPtr Create();
+
+    size_t Register(const std::string& name);
+    void Record(size_t index, bool success, double createMs);
+
+    const std::vector<Entry>& GetEntries() const { return m_entries; }
+    // 만든 리소스는 사용한 순서대로, 만들지 않은 리소스는 이름만 출력
+    void LogTrace() const;
+
+private:
+    ResourceRegistry() {}
+
+    std::chrono::steady_clock::time_point m_start;
+    std::vector<Entry> m_entries;
+};
+
+template <typename T>
+class LazyResource {
+public:
+    using Factory = std::function<std::unique_ptr<T>()>;
+
+    void Init(ResourceRegistry* registry, const std::string& name, Factory create) {
+        m_registry = registry;
+        m_index = registry->Register(name);
+        m_create = std::move(create);
+    }
+
+    // 처음 호출할 때 생성, 실패하면 nullptr (Reset 전까지 다시 시도하지 않음)
+    T* Get() {
+        if (!m_created)
+            Create();
+        return m_resource.get();
+    }
+    bool IsCreated() const { return m_resource != nullptr; }
+    // 다음 Get에서 다시 생성 (창 크기 변경 등)
+    void Reset() {
+        m_resource.reset();
+        m_created = false;
+    }
+
+private:
+    void Create() {
+        auto start = std::chrono::steady_clock::now();
+        m_resource = m_create();
+        m_created = true;
+        auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+        m_registry->Record(m_index, m_resource != nullptr, elapsed.count());
+    }
+
+    ResourceRegistry* m_registry { nullptr };
+    size_t m_index { 0 };
+    Factory m_create;
+    std::unique_ptr<T> m_resource;
+    bool m_created { false };
+};
+
+#endif // __RESOURCE_REGISTRY_H__
\ No newline at end of file
@@ -6,6 +6,12 @@ ShaderUPtr Shader::CreateFromFile(const std::string& filename, GLenum shaderType
 	return std::move(shader); // 스마트 포인터의 메모리 소유권을 밖으로 넘기는 함수
 }
 
+ShaderUPtr Shader::CreateFromSource(const std::string& code, GLenum shaderType, const std::string& name) {
+	auto shader = ShaderUPtr(new Shader());
+	if (!shader->Compile(code, shaderType, name)) return nullptr;
+	return std::move(shader);
+}
+
 Shader::~Shader(){
     if(m_shader){
         glDeleteShader(m_shader);
@@ -16,7 +22,10 @@ bool Shader::LoadFile(const std::string& filename, GLenum shaderType) {
 	auto result = LoadTextFile(filename);
 	if (!result.has_value()) return false; // optional의 값이 존재하는지 확인
 	
-	auto& code = result.value();
+	return Compile(result.value(), shaderType, filename);
+}
+
+bool Shader::Compile(const std::string& code, GLenum shaderType, const std::string& name) {
 	const char* codePtr = code.c_str();
 	int32_t codeLength = (int32_t)code.length();
 
@@ -31,7 +40,7 @@ bool Shader::LoadFile(const std::string& filename, GLenum shaderType) {
 	if (!success) {
 		char infoLog[1024];
 		glGetShaderInfoLog(m_shader, 1024, nullptr, infoLog);
-		SPDLOG_ERROR("failed to compile shader: \"{}\"", filename);
+		SPDLOG_ERROR("failed to compile shader: \"{}\"", name);
 		SPDLOG_ERROR("reason: {}", infoLog);
 		return false;
 	}
@@ -12,6 +12,8 @@ CLASS_PTR(Shader);
 class Shader {
 public:
 	static ShaderUPtr CreateFromFile(const std::string& filename, GLenum shaderType);
+	// name은 에러 메시지에만 사용
+	static ShaderUPtr CreateFromSource(const std::string& code, GLenum shaderType, const std::string& name);
 	
 	~Shader();
 	uint32_t Get() const { return m_shader; }
@@ -19,6 +21,7 @@ public:
 private:
 	Shader() {}
 	bool LoadFile(const std::string& filename, GLenum shaderType);
+	bool Compile(const std::string& code, GLenum shaderType, const std::string& name);
 	uint32_t m_shader{ 0 }; // openGL 쉐이더의 id를 저장하는 변수
 };
 
@@ -1,4 +1,81 @@
 #include "texture.h"
+#include <algorithm>
+#include <filesystem>
+
+// glad에 확장 없이 생성되어 있으면 정의되지 않음
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+
+namespace {
+
+std::string s_fileCacheDirectory;
+bool s_compressFiles { false };
+
+uint32_t GetFileInternalFormat(const TextureFile* file) {
+    switch (file->GetFormat()) {
+        case TextureFile::Format::BC1: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case TextureFile::Format::BC4: return GL_COMPRESSED_RED_RGTC1;
+        default: return Texture::GetImageFormat(file->GetChannelCount());
+    }
+}
+
+// level 0 부터 levelCount개 업로드
+void UploadFileLevels(GLenum target, const TextureFile* file, uint32_t internalFormat, int levelCount) {
+    GLenum format = Texture::GetImageFormat(file->GetChannelCount());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for (int i = 0; i < levelCount; i++) {
+        auto& level = file->GetLevel(i);
+        if (file->GetFormat() == TextureFile::Format::Raw) {
+            glTexImage2D(target, i, internalFormat, level.width, level.height, 0,
+                format, GL_UNSIGNED_BYTE, level.data);
+        }
+        else {
+            glCompressedTexImage2D(target, i, internalFormat, level.width, level.height, 0,
+                (GLsizei)level.size, level.data);
+        }
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+// 캐시 디렉토리의 변환 파일을 열거나 새로 변환
+TextureFileUPtr LoadFile(const std::string& filepath, bool flipVertical) {
+    // S3TC가 없어도 미리 압축 변환해둔 파일 (treegen_texconv --compress) 중 BC1이 아닌 것은 사용 가능
+    if (!s_compressFiles && TextureFile::IsUpToDate(s_fileCacheDirectory, filepath, flipVertical, true)) {
+        auto file = TextureFile::Open(TextureFile::GetCachePath(s_fileCacheDirectory, filepath, flipVertical, true));
+        if (file && file->GetFormat() != TextureFile::Format::BC1)
+            return std::move(file);
+    }
+    return TextureFile::LoadOrConvert(s_fileCacheDirectory, filepath, flipVertical, s_compressFiles);
+}
+
+} // namespace
+
+void Texture::SetFileCacheDirectory(const std::string& directory, bool compress) {
+    s_fileCacheDirectory = directory;
+    s_compressFiles = compress && IsFormatSupported(TextureFile::Format::BC1);
+    if (directory.empty())
+        return;
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        SPDLOG_ERROR("failed to create texture cache directory: {}", directory);
+        s_fileCacheDirectory.clear();
+    }
+}
+
+bool Texture::IsFormatSupported(TextureFile::Format format) {
+    // RGTC는 GL 3.0부터 core
+    if (format != TextureFile::Format::BC1)
+        return true;
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &count);
+    if (count <= 0)
+        return false;
+    std::vector<GLint> formats(count);
+    glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, formats.data());
+    return std::find(formats.begin(), formats.end(), GL_COMPRESSED_RGB_S3TC_DXT1_EXT) != formats.end();
+}
 
 TextureUPtr Texture::Create(int width, int height, uint32_t format, uint32_t type) {
     auto texture = TextureUPtr(new Texture());
@@ -15,6 +92,33 @@ TextureUPtr Texture::CreateFromImage(const Image* image) {
     return std::move(texture);
 }
 
+TextureUPtr Texture::CreateForImage(const Image* image) {
+    auto texture = TextureUPtr(new Texture());
+    texture->CreateTexture();
+    texture->SetTextureFormat(image->GetWidth(), image->GetHeight(),
+        GetImageFormat(image->GetChannelCount()), GL_UNSIGNED_BYTE);
+    return std::move(texture);
+}
+
+TextureUPtr Texture::CreateFromFile(const TextureFile* file) {
+    auto texture = TextureUPtr(new Texture());
+    texture->CreateTexture();
+    texture->SetTextureFromFile(file);
+    return std::move(texture);
+}
+
+TextureUPtr Texture::Load(const std::string& filepath, bool flipVertical) {
+    if (!s_fileCacheDirectory.empty()) {
+        auto file = LoadFile(filepath, flipVertical);
+        if (file)
+            return CreateFromFile(file.get());
+    }
+    auto image = Image::Load(filepath, flipVertical);
+    if (!image)
+        return nullptr;
+    return CreateFromImage(image.get());
+}
+
 Texture::~Texture() {
     if (m_texture) {
         glDeleteTextures(1, &m_texture);
@@ -40,6 +144,23 @@ void Texture::SetBorderColor(const glm::vec4& color) const {
     glm::value_ptr(color));
 }
 
+// image의 yOffset 부터 rows 줄만 업로드
+void Texture::SetSubImage(const Image* image, int yOffset, int rows) const {
+    int channelCount = image->GetChannelCount();
+    Bind();
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, yOffset, m_width, rows,
+        GetImageFormat(channelCount), GL_UNSIGNED_BYTE,
+        image->GetData() + (size_t)yOffset * m_width * channelCount);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+void Texture::GenerateMipmap() const {
+    Bind();
+    glGenerateMipmap(GL_TEXTURE_2D);
+    SetFilter(GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR);
+}
+
 // 이미지 데이터는 복사하지 않고 메모리만 할당
 void Texture::SetTextureFormat(int width, int height, uint32_t format, uint32_t type) {
     m_width = width;
@@ -82,13 +203,7 @@ void Texture::CreateTexture() {
 
 // 이미지 데이터를 복사사
 void Texture::SetTextureFromImage(const Image* image) {
-    GLenum format = GL_RGBA;
-    switch (image->GetChannelCount()) {
-        default: break;
-        case 1: format = GL_RED; break;
-        case 2: format = GL_RG; break;
-        case 3: format = GL_RGB; break;
-    }
+    GLenum format = GetImageFormat(image->GetChannelCount());
     
     m_width = image->GetWidth();
     m_height = image->GetHeight();
@@ -101,6 +216,25 @@ void Texture::SetTextureFromImage(const Image* image) {
     glGenerateMipmap(GL_TEXTURE_2D);
 }
 
+void Texture::SetTextureFromFile(const TextureFile* file) {
+    m_width = file->GetWidth();
+    m_height = file->GetHeight();
+    m_format = GetFileInternalFormat(file);
+    m_type = GL_UNSIGNED_BYTE;
+
+    UploadFileLevels(GL_TEXTURE_2D, file, m_format, file->GetLevelCount());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, file->GetLevelCount() - 1);
+}
+
+uint32_t Texture::GetImageFormat(int channelCount) {
+    switch (channelCount) {
+        default: return GL_RGBA;
+        case 1: return GL_RED;
+        case 2: return GL_RG;
+        case 3: return GL_RGB;
+    }
+}
+
 // cube texture 클래스 구현
 CubeTextureUPtr CubeTexture::CreateFromImages(const std::vector<Image*>& images) {
     auto texture = CubeTextureUPtr(new CubeTexture());
@@ -108,6 +242,40 @@ CubeTextureUPtr CubeTexture::CreateFromImages(const std::vector<Image*>& images)
     return std::move(texture);
 }
 
+CubeTextureUPtr CubeTexture::CreateFromFiles(const std::vector<const TextureFile*>& files) {
+    auto texture = CubeTextureUPtr(new CubeTexture());
+    if (!texture->InitFromFiles(files)) return nullptr;
+    return std::move(texture);
+}
+
+CubeTextureUPtr CubeTexture::Load(const std::vector<std::string>& filepaths) {
+    if (!s_fileCacheDirectory.empty()) {
+        std::vector<TextureFileUPtr> files;
+        for (auto& filepath : filepaths) {
+            auto file = LoadFile(filepath, false);
+            if (!file)
+                break;
+            files.push_back(std::move(file));
+        }
+        if (files.size() == filepaths.size()) {
+            std::vector<const TextureFile*> filePointers;
+            for (auto& file : files)
+                filePointers.push_back(file.get());
+            return CreateFromFiles(filePointers);
+        }
+    }
+
+    std::vector<ImageUPtr> images;
+    std::vector<Image*> imagePointers;
+    for (auto& filepath : filepaths) {
+        images.push_back(Image::Load(filepath, false));
+        if (!images.back())
+            return nullptr;
+        imagePointers.push_back(images.back().get());
+    }
+    return CreateFromImages(imagePointers);
+}
+
 CubeTexture::~CubeTexture() {
     if (m_texture) {
         glDeleteTextures(1, &m_texture);
@@ -144,5 +312,27 @@ bool CubeTexture::InitFromImages(const std::vector<Image*>& images) {
             image->GetData());
     }
 
+    return true;
+}
+
+// skybox는 GL_LINEAR로만 샘플링하므로 level 0만 업로드
+bool CubeTexture::InitFromFiles(const std::vector<const TextureFile*>& files) {
+    glGenTextures(1, &m_texture);
+    Bind();
+
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, 0);
+
+    for (uint32_t i = 0; i < (uint32_t)files.size(); i++) {
+        auto file = files[i];
+        uint32_t internalFormat = file->GetFormat() == TextureFile::Format::Raw ?
+            GL_RGB : GetFileInternalFormat(file);
+        UploadFileLevels(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, file, internalFormat, 1);
+    }
+
     return true;
 }
\ No newline at end of file
@@ -1,7 +1,9 @@
 #ifndef __TEXTURE_H__
 #define __TEXTURE_H__
 
+#include "common.h"
 #include "image.h"
+#include "texture_file.h"
 
 CLASS_PTR(Texture)
 class Texture {
@@ -9,6 +11,18 @@ public:
     static TextureUPtr Create(int width, int height,
         uint32_t format, uint32_t type = GL_UNSIGNED_BYTE);
     static TextureUPtr CreateFromImage(const Image* image);
+    // 이미지 크기와 포맷으로 메모리만 할당, 데이터는 SetSubImage로 나눠서 업로드
+    static TextureUPtr CreateForImage(const Image* image);
+    // 파일에 있는 mip chain을 그대로 업로드 (glGenerateMipmap 없음)
+    static TextureUPtr CreateFromFile(const TextureFile* file);
+    // 캐시 디렉토리가 설정되어 있으면 변환 파일로, 아니면 Image::Load로 만듦
+    static TextureUPtr Load(const std::string& filepath, bool flipVertical = true);
+
+    // 설정하면 Load가 이미지를 .tgtex로 변환해두고 다음부터는 디코딩 없이 불러옴 (빈 문자열이면 사용 안 함)
+    // compress는 드라이버가 S3TC를 지원할 때만 적용
+    static void SetFileCacheDirectory(const std::string& directory, bool compress = false);
+    // Raw는 항상 true
+    static bool IsFormatSupported(TextureFile::Format format);
     ~Texture();
 
     const uint32_t Get() const { return m_texture; }
@@ -16,16 +30,21 @@ public:
     void SetFilter(uint32_t minFilter, uint32_t magFilter) const;
     void SetWrap(uint32_t sWrap, uint32_t tWrap) const; // mirror repeat ...
     void SetBorderColor(const glm::vec4& color) const;
+    void SetSubImage(const Image* image, int yOffset, int rows) const;
+    void GenerateMipmap() const;
 
     int GetWidth() const { return m_width; }
     int GetHeight() const { return m_height; }
     uint32_t GetFormat() const { return m_format; }
     uint32_t GetType() const { return m_type; }
     
+    static uint32_t GetImageFormat(int channelCount);
+
 private:
     Texture() {}
     void CreateTexture();
     void SetTextureFromImage(const Image* image);
+    void SetTextureFromFile(const TextureFile* file);
     void SetTextureFormat(int width, int height, uint32_t format, uint32_t type);
 
     uint32_t m_texture { 0 };
@@ -39,6 +58,9 @@ CLASS_PTR(CubeTexture)
 class CubeTexture {
 public:
     static CubeTextureUPtr CreateFromImages(const std::vector<Image*>& images);
+    static CubeTextureUPtr CreateFromFiles(const std::vector<const TextureFile*>& files);
+    // Texture::SetFileCacheDirectory 설정을 따름, 이미지는 뒤집지 않음
+    static CubeTextureUPtr Load(const std::vector<std::string>& filepaths);
     ~CubeTexture();
 
     const uint32_t Get() const { return m_texture; }
@@ -46,6 +68,7 @@ public:
 private:
     CubeTexture() {}
     bool InitFromImages(const std::vector<Image*>& images);
+    bool InitFromFiles(const std::vector<const TextureFile*>& files);
     uint32_t m_texture { 0 };
 };
 
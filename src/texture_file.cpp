@@ -0,0 +1,366 @@
+#include "texture_file.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+const char TEXTURE_MAGIC[4] = { 'T', 'G', 'T', 'X' };
+const char* TEXTURE_EXTENSION = ".tgtex";
+// 매핑된 주소에서 level 데이터를 바로 넘겨주므로 시작 위치를 정렬
+const size_t LEVEL_ALIGNMENT = 16;
+// BC1, BC4 모두 4x4 블록 하나가 8바이트
+const size_t BLOCK_BYTES = 8;
+const uint32_t MAX_LEVEL_COUNT = 32;
+
+struct TextureFileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t channelCount;
+    uint32_t format;
+    uint32_t levelCount;
+    uint32_t reserved;
+    uint64_t sourceStamp;
+};
+
+struct TextureLevelEntry {
+    uint32_t width;
+    uint32_t height;
+    uint64_t offset; // 파일 처음부터
+    uint64_t size;
+};
+
+struct LevelImage {
+    int width;
+    int height;
+    const uint8_t* data;
+};
+
+size_t GetLevelSize(TextureFile::Format format, int width, int height, int channelCount) {
+    if (format == TextureFile::Format::Raw)
+        return (size_t)width * height * channelCount;
+    return (size_t)((width + 3) / 4) * ((height + 3) / 4) * BLOCK_BYTES;
+}
+
+// 2x2 box filter (glGenerateMipmap과 같은 방식), 홀수 크기면 마지막 줄/열을 한 번 더 사용
+void Downsample(const LevelImage& src, int channelCount, std::vector<uint8_t>& dst, int& width, int& height) {
+    width = std::max(1, src.width / 2);
+    height = std::max(1, src.height / 2);
+    dst.resize((size_t)width * height * channelCount);
+    for (int y = 0; y < height; y++) {
+        const uint8_t* row0 = src.data + (size_t)std::min(2 * y, src.height - 1) * src.width * channelCount;
+        const uint8_t* row1 = src.data + (size_t)std::min(2 * y + 1, src.height - 1) * src.width * channelCount;
+        uint8_t* out = dst.data() + (size_t)y * width * channelCount;
+        for (int x = 0; x < width; x++) {
+            int x0 = std::min(2 * x, src.width - 1) * channelCount;
+            int x1 = std::min(2 * x + 1, src.width - 1) * channelCount;
+            for (int c = 0; c < channelCount; c++)
+                *out++ = (uint8_t)((row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) / 4);
+        }
+    }
+}
+
+// 4x4 블록의 texel을 가져옴, 이미지 밖은 가장자리 texel로 채움
+void FetchBlock(const LevelImage& level, int channelCount, int blockX, int blockY, uint8_t block[16][4]) {
+    for (int j = 0; j < 4; j++) {
+        int y = std::min(blockY * 4 + j, level.height - 1);
+        for (int i = 0; i < 4; i++) {
+            int x = std::min(blockX * 4 + i, level.width - 1);
+            memcpy(block[j * 4 + i], level.data + ((size_t)y * level.width + x) * channelCount, channelCount);
+        }
+    }
+}
+
+uint16_t ToRGB565(const int* color) {
+    return (uint16_t)(((color[0] >> 3) << 11) | ((color[1] >> 2) << 5) | (color[2] >> 3));
+}
+
+void FromRGB565(uint16_t value, int* color) {
+    int r = (value >> 11) & 31;
+    int g = (value >> 5) & 63;
+    int b = value & 31;
+    color[0] = (r << 3) | (r >> 2);
+    color[1] = (g << 2) | (g >> 4);
+    color[2] = (b << 3) | (b >> 2);
+}
+
+// J.M.P. van Waveren, "Real-Time DXT Compression" 의 bounding box 방식
+void EncodeBC1(const uint8_t block[16][4], uint8_t* out) {
+    int minColor[3] = { 255, 255, 255 };
+    int maxColor[3] = { 0, 0, 0 };
+    for (int i = 0; i < 16; i++) {
+        for (int c = 0; c < 3; c++) {
+            minColor[c] = std::min(minColor[c], (int)block[i][c]);
+            maxColor[c] = std::max(maxColor[c], (int)block[i][c]);
+        }
+    }
+    // 양 끝 색이 튀는 texel 쪽으로 치우치지 않도록 범위의 1/16 만큼 안쪽으로 당김
+    for (int c = 0; c < 3; c++) {
+        int inset = (maxColor[c] - minColor[c]) >> 4;
+        minColor[c] += inset;
+        maxColor[c] -= inset;
+    }
+
+    // color0 > color1 이어야 4색 모드
+    uint16_t color0 = ToRGB565(maxColor);
+    uint16_t color1 = ToRGB565(minColor);
+    if (color0 < color1)
+        std::swap(color0, color1);
+    out[0] = (uint8_t)(color0 & 0xff);
+    out[1] = (uint8_t)(color0 >> 8);
+    out[2] = (uint8_t)(color1 & 0xff);
+    out[3] = (uint8_t)(color1 >> 8);
+
+    uint32_t indices = 0;
+    if (color0 != color1) {
+        int palette[4][3];
+        FromRGB565(color0, palette[0]);
+        FromRGB565(color1, palette[1]);
+        for (int c = 0; c < 3; c++) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+        for (int i = 0; i < 16; i++) {
+            int best = 0;
+            int bestDistance = INT32_MAX;
+            for (int k = 0; k < 4; k++) {
+                int distance = 0;
+                for (int c = 0; c < 3; c++) {
+                    int d = (int)block[i][c] - palette[k][c];
+                    distance += d * d;
+                }
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = k;
+                }
+            }
+            indices |= (uint32_t)best << (2 * i);
+        }
+    }
+    for (int k = 0; k < 4; k++)
+        out[4 + k] = (uint8_t)(indices >> (8 * k));
+}
+
+// red0 > red1 인 8단계 모드만 사용
+void EncodeBC4(const uint8_t block[16][4], uint8_t* out) {
+    int minValue = 255;
+    int maxValue = 0;
+    for (int i = 0; i < 16; i++) {
+        minValue = std::min(minValue, (int)block[i][0]);
+        maxValue = std::max(maxValue, (int)block[i][0]);
+    }
+    out[0] = (uint8_t)maxValue;
+    out[1] = (uint8_t)minValue;
+
+    uint64_t indices = 0;
+    if (maxValue > minValue) {
+        int range = maxValue - minValue;
+        for (int i = 0; i < 16; i++) {
+            // step 0 = red0 (max), step 7 = red1 (min), 사이 값은 인덱스 2 ~ 7
+            int step = ((maxValue - block[i][0]) * 7 + range / 2) / range;
+            int index = step == 0 ? 0 : (step == 7 ? 1 : step + 1);
+            indices |= (uint64_t)index << (3 * i);
+        }
+    }
+    for (int k = 0; k < 6; k++)
+        out[2 + k] = (uint8_t)(indices >> (8 * k));
+}
+
+void EncodeBlocks(const LevelImage& level, int channelCount, TextureFile::Format format, uint8_t* out) {
+    uint8_t block[16][4] = {};
+    int blockCountX = (level.width + 3) / 4;
+    int blockCountY = (level.height + 3) / 4;
+    for (int by = 0; by < blockCountY; by++) {
+        for (int bx = 0; bx < blockCountX; bx++) {
+            FetchBlock(level, channelCount, bx, by, block);
+            if (format == TextureFile::Format::BC1)
+                EncodeBC1(block, out);
+            else
+                EncodeBC4(block, out);
+            out += BLOCK_BYTES;
+        }
+    }
+}
+
+size_t AlignOffset(size_t offset) {
+    return (offset + LEVEL_ALIGNMENT - 1) / LEVEL_ALIGNMENT * LEVEL_ALIGNMENT;
+}
+
+// 파일 전체 내용을 만듦
+std::string Serialize(const Image* image, bool compress, uint64_t sourceStamp) {
+    int channelCount = image->GetChannelCount();
+    auto format = TextureFile::Format::Raw;
+    if (compress && channelCount == 3)
+        format = TextureFile::Format::BC1;
+    else if (compress && channelCount == 1)
+        format = TextureFile::Format::BC4;
+
+    // level 0은 이미지 데이터를 그대로 사용
+    std::vector<std::vector<uint8_t>> storage;
+    std::vector<LevelImage> levels;
+    levels.push_back({ image->GetWidth(), image->GetHeight(), image->GetData() });
+    while ((levels.back().width > 1 || levels.back().height > 1) && levels.size() < MAX_LEVEL_COUNT) {
+        LevelImage next;
+        storage.emplace_back();
+        Downsample(levels.back(), channelCount, storage.back(), next.width, next.height);
+        next.data = storage.back().data();
+        levels.push_back(next);
+    }
+
+    TextureFileHeader header;
+    memcpy(header.magic, TEXTURE_MAGIC, sizeof(TEXTURE_MAGIC));
+    header.version = TextureFile::VERSION;
+    header.width = (uint32_t)image->GetWidth();
+    header.height = (uint32_t)image->GetHeight();
+    header.channelCount = (uint32_t)channelCount;
+    header.format = (uint32_t)format;
+    header.levelCount = (uint32_t)levels.size();
+    header.reserved = 0;
+    header.sourceStamp = sourceStamp;
+
+    std::vector<TextureLevelEntry> entries(levels.size());
+    size_t offset = sizeof(header) + entries.size() * sizeof(TextureLevelEntry);
+    for (size_t i = 0; i < levels.size(); i++) {
+        offset = AlignOffset(offset);
+        entries[i].width = (uint32_t)levels[i].width;
+        entries[i].height = (uint32_t)levels[i].height;
+        entries[i].offset = offset;
+        entries[i].size = GetLevelSize(format, levels[i].width, levels[i].height, channelCount);
+        offset += entries[i].size;
+    }
+
+    std::string out(offset, '\0');
+    memcpy(&out[0], &header, sizeof(header));
+    memcpy(&out[sizeof(header)], entries.data(), entries.size() * sizeof(TextureLevelEntry));
+    for (size_t i = 0; i < levels.size(); i++) {
+        auto dst = (uint8_t*)&out[entries[i].offset];
+        if (format == TextureFile::Format::Raw)
+            memcpy(dst, levels[i].data, entries[i].size);
+        else
+            EncodeBlocks(levels[i], channelCount, format, dst);
+    }
+    return out;
+}
+
+} // namespace
+
+bool TextureFile::Write(const std::string& path, const Image* image, bool compress, uint64_t sourceStamp) {
+    if (!image || !image->GetData())
+        return false;
+    return WriteFileAtomic(path, { Serialize(image, compress, sourceStamp) });
+}
+
+TextureFileUPtr TextureFile::Open(const std::string& path) {
+    auto file = MappedFile::Open(path);
+    if (!file)
+        return nullptr;
+    auto textureFile = TextureFileUPtr(new TextureFile());
+    if (!textureFile->Parse(file->GetData(), file->GetSize(), path))
+        return nullptr;
+    textureFile->m_file = std::move(file);
+    return std::move(textureFile);
+}
+
+bool TextureFile::Parse(const char* data, size_t size, const std::string& path) {
+    TextureFileHeader header;
+    bool valid = size >= sizeof(header);
+    if (valid) {
+        memcpy(&header, data, sizeof(header));
+        valid = memcmp(header.magic, TEXTURE_MAGIC, sizeof(TEXTURE_MAGIC)) == 0 && header.version == VERSION &&
+            header.width > 0 && header.height > 0 &&
+            header.channelCount >= 1 && header.channelCount <= 4 &&
+            header.format <= (uint32_t)Format::BC4 &&
+            header.levelCount >= 1 && header.levelCount <= MAX_LEVEL_COUNT &&
+            size >= sizeof(header) + header.levelCount * sizeof(TextureLevelEntry);
+    }
+    if (valid) {
+        m_width = (int)header.width;
+        m_height = (int)header.height;
+        m_channelCount = (int)header.channelCount;
+        m_format = (Format)header.format;
+        m_sourceStamp = header.sourceStamp;
+        m_levels.resize(header.levelCount);
+        for (uint32_t i = 0; i < header.levelCount && valid; i++) {
+            TextureLevelEntry entry;
+            memcpy(&entry, data + sizeof(header) + i * sizeof(entry), sizeof(entry));
+            // level 크기는 저장된 값이 아니라 형식에서 다시 계산해서 확인
+            int width = std::max(1, m_width >> i);
+            int height = std::max(1, m_height >> i);
+            valid = entry.width == (uint32_t)width && entry.height == (uint32_t)height &&
+                entry.size == GetLevelSize(m_format, width, height, m_channelCount) &&
+                entry.offset <= size && entry.size <= size - entry.offset;
+            m_levels[i] = { width, height, (const uint8_t*)data + entry.offset, (size_t)entry.size };
+        }
+    }
+    if (!valid) {
+        SPDLOG_ERROR("invalid texture file: {}", path);
+        return false;
+    }
+    return true;
+}
+
+uint64_t TextureFile::GetSourceStamp(const std::string& sourcePath) {
+    std::error_code error;
+    uint64_t values[2];
+    values[0] = (uint64_t)std::filesystem::file_size(sourcePath, error);
+    if (error)
+        return 0;
+    values[1] = (uint64_t)std::filesystem::last_write_time(sourcePath, error).time_since_epoch().count();
+    if (error)
+        return 0;
+    uint64_t stamp = HashBytes(values, sizeof(values));
+    return stamp ? stamp : 1;
+}
+
+std::string TextureFile::GetCachePath(const std::string& directory, const std::string& sourcePath,
+    bool flipVertical, bool compress) {
+    std::string key = fmt::format("{}|{}|{}", sourcePath, flipVertical ? 1 : 0, compress ? 1 : 0);
+    return fmt::format("{}/{:016x}{}", directory, HashBytes(key.data(), key.size()), TEXTURE_EXTENSION);
+}
+
+bool TextureFile::IsUpToDate(const std::string& directory, const std::string& sourcePath,
+    bool flipVertical, bool compress) {
+    std::string path = GetCachePath(directory, sourcePath, flipVertical, compress);
+    std::error_code error;
+    if (!std::filesystem::exists(path, error))
+        return false;
+    // header만 읽어서 확인
+    TextureFileHeader header;
+    std::ifstream in(path, std::ios::binary);
+    if (!in.read((char*)&header, sizeof(header)))
+        return false;
+    if (memcmp(header.magic, TEXTURE_MAGIC, sizeof(TEXTURE_MAGIC)) != 0 || header.version != VERSION)
+        return false;
+    uint64_t stamp = GetSourceStamp(sourcePath);
+    return stamp == 0 || header.sourceStamp == stamp;
+}
+
+TextureFileUPtr TextureFile::LoadOrConvert(const std::string& directory, const std::string& sourcePath,
+    bool flipVertical, bool compress) {
+    std::string path = GetCachePath(directory, sourcePath, flipVertical, compress);
+    uint64_t stamp = GetSourceStamp(sourcePath);
+    std::error_code error;
+    if (std::filesystem::exists(path, error)) {
+        auto file = Open(path);
+        // 원본이 없으면 미리 변환해둔 파일만 있는 경우이므로 그대로 사용
+        if (file && (stamp == 0 || file->m_sourceStamp == stamp))
+            return std::move(file);
+    }
+
+    auto image = Image::Load(sourcePath, flipVertical);
+    if (!image)
+        return nullptr;
+    auto textureFile = TextureFileUPtr(new TextureFile());
+    textureFile->m_buffer = Serialize(image.get(), compress, stamp);
+    image.reset();
+
+    // 저장에 실패해도 이번 실행에서는 메모리에 있는 내용을 사용
+    std::filesystem::create_directories(directory, error);
+    if (WriteFileAtomic(path, { textureFile->m_buffer }))
+        SPDLOG_INFO("converted texture: {} -> {}", sourcePath, path);
+    if (!textureFile->Parse(textureFile->m_buffer.data(), textureFile->m_buffer.size(), path))
+        return nullptr;
+    return std::move(textureFile);
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+#ifndef __TEXTURE_FILE_H__
+#define __TEXTURE_FILE_H__
+
+#include "core_common.h"
+#include "image.h"
+#include "mapped_file.h"
+#include <vector>
+
+/*
+GPU에 바로 올릴 수 있는 텍스쳐 파일 (.tgtex)
+1. header + level 테이블 + level 데이터 (level 0 부터 1x1 까지 전부)
+2. mip chain은 변환할 때 CPU에서 2x2 box filter로 미리 만들어 둠 (glGenerateMipmap 불필요)
+3. 압축 변환이면 3채널은 BC1 (S3TC DXT1), 1채널은 BC4 (RGTC1), 나머지 채널 수는 그대로 저장
+열 때는 MappedFile로 매핑만 하고 디코딩하지 않음
+*/
+CLASS_PTR(TextureFile)
+class TextureFile {
+public:
+    // 파일 형식이나 mip 생성 방식이 바뀌면 올려서 이전 변환 파일을 무효화
+    static const uint32_t VERSION = 1;
+
+    enum class Format : uint32_t { Raw = 0, BC1 = 1, BC4 = 2 };
+
+    struct Level {
+        int width;
+        int height;
+        const uint8_t* data;
+        size_t size;
+    };
+
+    // sourceStamp는 원본이 바뀌었는지 확인하는 값 (GetSourceStamp)
+    static bool Write(const std::string& path, const Image* image, bool compress, uint64_t sourceStamp = 0);
+    static TextureFileUPtr Open(const std::string& path);
+
+    // 원본 파일의 크기와 수정 시간으로 만든 값, 원본이 없으면 0
+    static uint64_t GetSourceStamp(const std::string& sourcePath);
+    // directory 안의 변환 파일 경로 (원본 경로, flip, 압축 여부로 이름 결정)
+    static std::string GetCachePath(const std::string& directory, const std::string& sourcePath,
+        bool flipVertical, bool compress);
+    // 변환 파일이 있고 원본이 바뀌지 않았으면 true (원본이 없으면 변환 파일만 확인)
+    static bool IsUpToDate(const std::string& directory, const std::string& sourcePath,
+        bool flipVertical, bool compress);
+    // 변환 파일을 열고, 없거나 원본이 바뀌었으면 Image::Load로 디코딩해서 변환한 뒤 열기
+    static TextureFileUPtr LoadOrConvert(const std::string& directory, const std::string& sourcePath,
+        bool flipVertical = true, bool compress = false);
+
+    int GetWidth() const { return m_width; }
+    int GetHeight() const { return m_height; }
+    int GetChannelCount() const { return m_channelCount; }
+    Format GetFormat() const { return m_format; }
+    uint64_t GetSourceStamp() const { return m_sourceStamp; }
+    int GetLevelCount() const { return (int)m_levels.size(); }
+    const Level& GetLevel(int level) const { return m_levels[level]; }
+
+private:
+    TextureFile() {}
+    bool Parse(const char* data, size_t size, const std::string& path);
+
+    // level 데이터는 둘 중 하나를 가리킴 (방금 변환했으면 m_buffer)
+    MappedFileUPtr m_file;
+    std::string m_buffer;
+    int m_width { 0 };
+    int m_height { 0 };
+    int m_channelCount { 0 };
+    Format m_format { Format::Raw };
+    uint64_t m_sourceStamp { 0 };
+    std::vector<Level> m_levels;
+};
+
+#endif // __TEXTURE_FILE_H__
\ No newline at end of file
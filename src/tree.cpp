@@ -0,0 +1,609 @@
+#include "tree.h"
+#include "tree_file.h"
+#include "turtle_vm.h"
+#include "geometry.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+static TreeCachePtr s_cache;
+
+void TreeTransforms::GetAffine(size_t index, float* values) const {
+    if (!quantized) {
+        memcpy(values, (const float*)data + index * FLOAT_COUNT, FLOAT_COUNT * sizeof(float));
+        return;
+    }
+    auto q = (const uint16_t*)data + index * FLOAT_COUNT;
+    for (size_t k = 0; k < FLOAT_COUNT; k++)
+        values[k] = minimum[k] + q[k] * scale[k];
+}
+
+glm::mat4 TreeTransforms::Get(size_t index) const {
+    float values[FLOAT_COUNT];
+    GetAffine(index, values);
+    glm::mat4 m(1.0f);
+    for (int r = 0; r < 3; r++) {
+        for (int c = 0; c < 4; c++)
+            m[c][r] = values[r * 4 + c];
+    }
+    return m;
+}
+
+// glm은 열 우선이므로 행 우선 3x4로 바꿈
+void TreeTransforms::ToAffine(const glm::mat4& matrix, float* values) {
+    for (int r = 0; r < 3; r++) {
+        for (int c = 0; c < 4; c++)
+            values[r * 4 + c] = matrix[c][r];
+    }
+}
+
+void Tree::SetCache(TreeCachePtr cache) {
+    std::atomic_store(&s_cache, cache);
+}
+
+TreeCachePtr Tree::GetCache() {
+    return std::atomic_load(&s_cache);
+}
+
+TreeUPtr Tree::Create(std::string axiom, std::string rules, const std::vector<float>& treeParam, float angle, int iteration,
+        bool sphere, float xCoord, float zCoord, uint32_t seed, TreeProgress* progress, GenerationArena* arena,
+        bool storeInCache) {
+    auto tree = TreeUPtr(new Tree());
+    bool success = false;
+    {
+        // 이전 생성의 임시 데이터는 여기서 한 번에 해제 (Lease가 Reset)
+        GenerationArena::Lease lease(arena);
+        success = tree->Init(std::move(axiom), std::move(rules), treeParam, angle, iteration, sphere, xCoord, zCoord, seed, progress, arena,
+            storeInCache);
+        tree->m_progress = nullptr;
+        tree->m_cancel = nullptr;
+        tree->m_scratch = nullptr;
+    }
+    if(!success)
+        return nullptr;
+    
+    return std::move(tree);
+}
+
+TreeUPtr Tree::CreateFromFile(TreeFilePtr file) {
+    if (!file)
+        return nullptr;
+    auto tree = TreeUPtr(new Tree());
+    if (!tree->SetParameters(file->GetTreeParam()))
+        return nullptr;
+    tree->m_axiom = file->GetAxiom();
+    tree->m_rules = file->GetRules();
+    tree->m_angle = file->GetAngle();
+    tree->m_iteration = file->GetIteration();
+    tree->m_isSphere = file->IsSphere();
+    tree->m_seed = file->GetSeed();
+    tree->m_xCoord = file->GetXCoord();
+    tree->m_zCoord = file->GetZCoord();
+
+    // transform과 skeleton은 파일을 가지고 있는 동안 매핑된 메모리를 그대로 사용
+    auto start = std::chrono::steady_clock::now();
+    tree->m_file = std::move(file);
+    tree->MakeMeshes();
+    tree->m_timing.bake = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return std::move(tree);
+}
+
+TreeTransforms Tree::GetCylinderTransforms() const {
+    if (m_file)
+        return m_file->GetCylinderTransforms();
+    TreeTransforms transforms;
+    transforms.count = m_cylinderAffine.size() / TreeTransforms::FLOAT_COUNT;
+    transforms.data = m_cylinderAffine.data();
+    transforms.size = m_cylinderAffine.size() * sizeof(float);
+    return transforms;
+}
+
+TreeTransforms Tree::GetLeafTransforms() const {
+    if (m_file)
+        return m_file->GetLeafTransforms();
+    TreeTransforms transforms;
+    transforms.count = m_leafAffine.size() / TreeTransforms::FLOAT_COUNT;
+    transforms.data = m_leafAffine.data();
+    transforms.size = m_leafAffine.size() * sizeof(float);
+    return transforms;
+}
+
+bool Tree::SetParameters(const std::vector<float>& treeParam) {
+    if(treeParam.size() < 6) return false;
+    else if(treeParam[4] <= 0.0f && treeParam[5] <= 0.0f) return false;
+
+    m_cylinderRadius = treeParam[0];
+    m_cylinderHeight = treeParam[1];
+    m_leafRadius = treeParam[2];
+    m_leafHeight = treeParam[3];
+    m_radiusScaling = treeParam[4];
+    m_heightScaling = treeParam[5];
+    return true;
+}
+
+std::vector<float> Tree::GetTreeParam() const {
+    return { m_cylinderRadius, m_cylinderHeight, m_leafRadius, m_leafHeight, m_radiusScaling, m_heightScaling };
+}
+
+bool Tree::Init(std::string axiom, std::string rules, const std::vector<float>& treeParam, float angle, int iteration,
+    bool sphere, float xCoord, float zCoord, uint32_t seed, TreeProgress* progress, GenerationArena* arena,
+    bool storeInCache) {
+    if(!SetParameters(treeParam))
+        return false;
+
+    m_axiom = std::move(axiom);
+    m_rules = std::move(rules);
+
+    m_angle = angle;
+    m_iteration = iteration;
+    m_isSphere = sphere;
+    // 같은 seed면 같은 나무가 생성됨
+    m_seed = seed == RANDOM_SEED ? std::random_device()() : seed;
+
+    m_xCoord = xCoord;
+    m_zCoord = zCoord;
+    m_progress = progress;
+    m_cancel = progress ? &progress->cancel : nullptr;
+    m_scratch = arena;
+
+    auto cache = GetCache();
+    std::string canonical;
+    TreeCacheEntry entry;
+    if (cache) {
+        canonical = TreeCache::Canonicalize(m_axiom, m_rules, treeParam, m_angle, m_iteration, m_seed);
+    }
+    if (cache && cache->Load(canonical, entry)) {
+        m_codes = std::move(entry.codes);
+        m_cylinderVector = std::move(entry.cylinderMatrices);
+        m_leafVector = std::move(entry.leafMatrices);
+        m_skeleton = std::move(entry.skeleton);
+    }
+    else {
+        auto start = std::chrono::steady_clock::now();
+        m_codes = MakeCodes();
+        auto derived = std::chrono::steady_clock::now();
+        // m_cylinderHeight *= 1.2f;
+        // m_cylinderRadius *= 1.3f;
+        MakeCylinderMatrices();
+        if (IsCancelled())
+            return false;
+        auto interpreted = std::chrono::steady_clock::now();
+        m_timing.derive = std::chrono::duration<double, std::milli>(derived - start).count();
+        m_timing.interpret = std::chrono::duration<double, std::milli>(interpreted - derived).count();
+        // 무작위 seed의 나무는 다시 요청되지 않으므로 저장하면 다른 항목만 밀려남
+        if (cache && storeInCache && seed != RANDOM_SEED)
+            cache->Store(canonical, m_codes, m_cylinderVector, m_leafVector, m_skeleton);
+    }
+
+    auto bakeStart = std::chrono::steady_clock::now();
+    MakeMeshes();
+    MakeInstanceData();
+    m_timing.bake = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - bakeStart).count();
+    SetProgress(1.0f);
+
+    return true;
+}
+
+void Tree::MakeMeshes() {
+    m_logMesh = MakeCylinderMeshData(m_cylinderRadius, m_cylinderHeight, m_radiusScaling);
+    m_leafMesh = MakeLeafMeshData(m_leafRadius, m_leafHeight);
+    m_sphereMesh = MakeSphereMeshData(m_leafRadius);
+}
+
+// 해석 결과 행렬을 instance buffer에 그대로 올릴 수 있는 3x4 배열로 바꾸고 행렬은 버림
+void Tree::MakeInstanceData() {
+    auto Pack = [](std::vector<glm::mat4>& matrices, std::vector<float>& affine) {
+        affine.resize(matrices.size() * TreeTransforms::FLOAT_COUNT);
+        for (size_t i = 0; i < matrices.size(); i++)
+            TreeTransforms::ToAffine(matrices[i], affine.data() + i * TreeTransforms::FLOAT_COUNT);
+        std::vector<glm::mat4>().swap(matrices);
+    };
+    Pack(m_cylinderVector, m_cylinderAffine);
+    Pack(m_leafVector, m_leafAffine);
+}
+
+// 미리보기용 중간 iteration 나무 (같은 설정으로 codes만 다름)
+// 진행 상황은 기록하지 않고 취소만 같이 확인, 취소되면 nullptr
+TreeUPtr Tree::MakeIterationTree(std::string_view codes, int iteration) const {
+    auto tree = TreeUPtr(new Tree(*this));
+    tree->m_progress = nullptr;
+    tree->m_iteration = iteration;
+    tree->m_codes = codes;
+    tree->MakeCylinderMatrices();
+    if (tree->IsCancelled())
+        return nullptr;
+    tree->MakeMeshes();
+    tree->MakeInstanceData();
+    tree->m_cancel = nullptr;
+    tree->m_scratch = nullptr;
+    return tree;
+}
+
+size_t Tree::EstimateMemoryUsage(const std::string& axiom, const std::string& rules, int iteration, bool sphere) {
+    // MakeCodes와 같은 순서로 (F, X, A, C) 치환하면서 문자별 개수만 계산
+    // 규칙이 여러 개면 문자별로 가장 많이 늘어나는 경우를 사용
+    const char symbols[] = { 'F', 'X', 'A', 'C' };
+    std::vector<std::vector<double>> growth(4);
+    std::istringstream ss(rules);
+    std::string token;
+    while (std::getline(ss, token, '\n')) {
+        if (!token.empty() && token.back() == '\r')
+            token.pop_back();
+        std::size_t pos = token.rfind('=');
+        if(pos == std::string::npos) continue;
+        std::string condition = token.substr(0, pos);
+        for (int s = 0; s < 4; s++) {
+            if (condition.size() != 1 || condition[0] != symbols[s])
+                continue;
+            std::vector<double> count(256, 0.0);
+            for (unsigned char c : token.substr(pos + 1))
+                count[c] += 1.0;
+            if (growth[s].empty())
+                growth[s] = count;
+            for (int c = 0; c < 256; c++)
+                growth[s][c] = std::max(growth[s][c], count[c]);
+        }
+    }
+
+    std::vector<double> count(256, 0.0);
+    for (unsigned char c : axiom)
+        count[c] += 1.0;
+    for (int i = 0; i < iteration; i++) {
+        bool check[4];
+        for (int s = 0; s < 4; s++)
+            check[s] = count[(unsigned char)symbols[s]] > 0.0;
+        for (int s = 0; s < 4; s++) {
+            if (!check[s] || growth[s].empty())
+                continue;
+            double n = count[(unsigned char)symbols[s]];
+            count[(unsigned char)symbols[s]] = 0.0;
+            for (int c = 0; c < 256; c++)
+                count[c] += n * growth[s][c];
+        }
+    }
+
+    double length = 0.0;
+    for (auto n : count)
+        length += n;
+    double cylinderCount = count['F'] + count['X'] + count['A'] + count['C'];
+    double leafCount = count[']'];
+
+    // 문자열 + 행렬 (생성 중 복사본 포함) + export 할 때 만드는 v / vt / vn / f 배열 (vector 용량 증가를 고려해 2배)
+    auto logMesh = MakeCylinderMeshData();
+    auto leafMesh = sphere ? MakeSphereMeshData() : MakeLeafMeshData();
+    const double vertexExportSize = sizeof(float) * 8;
+    const double faceExportSize = sizeof(int) * 3;
+    double bytes = length * 2.0;
+    // 해석 전에 만드는 op 배열 ('['는 op가 없음)
+    bytes += (length - count['[']) * sizeof(TurtleOp);
+    bytes += (cylinderCount + leafCount) * sizeof(glm::mat4) * 2.0;
+    bytes += cylinderCount * (sizeof(int32_t) + 2 * sizeof(glm::vec3) + 2 * sizeof(float) + sizeof(uint16_t)) +
+        leafCount * sizeof(int32_t);
+    bytes += 2.0 * cylinderCount * (logMesh.vertices.size() * vertexExportSize + logMesh.indices.size() / 3 * faceExportSize);
+    bytes += 2.0 * leafCount * (leafMesh.vertices.size() * vertexExportSize + leafMesh.indices.size() / 3 * faceExportSize);
+    return bytes < (double)SIZE_MAX ? (size_t)bytes : SIZE_MAX;
+}
+
+std::string Tree::MakeCodes() {
+    std::mt19937 gen(m_seed); // 난수 엔진
+    auto scratch = GetScratch();
+
+    // 각 벡터에 변환 규칙을 삽입 (규칙 문자열은 m_rules를 가리키기만 함)
+    using RuleVector = std::pmr::vector<std::string_view>;
+    RuleVector F(scratch);
+    RuleVector X(scratch);
+    RuleVector A(scratch);
+    RuleVector C(scratch);
+    size_t lineStart = 0;
+    while (lineStart < m_rules.size()) {
+        size_t lineEnd = std::min(m_rules.find('\n', lineStart), m_rules.size());
+        std::string_view line(m_rules.data() + lineStart, lineEnd - lineStart);
+        lineStart = lineEnd + 1;
+        // CRLF 줄바꿈의 \r은 규칙에 포함하지 않음 (TreeCache::Canonicalize와 같은 규칙)
+        if(!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        std::size_t pos = line.rfind('=');
+        if(pos == std::string_view::npos) continue;
+
+        std::string_view condition = line.substr(0, pos);
+        std::string_view replace = line.substr(pos + 1);
+
+        if(condition == "F")
+            F.push_back(replace);
+        else if(condition == "X")
+            X.push_back(replace);
+        else if(condition == "A")
+            A.push_back(replace);
+        else if(condition == "C")
+            C.push_back(replace);
+    }
+
+    // 치환될 문자열, 치환은 두 버퍼를 번갈아 사용 (제자리 replace는 뒤쪽 문자열을 매번 옮겨야 함)
+    std::pmr::string result(m_axiom.data(), m_axiom.size(), scratch);
+    std::pmr::string next(scratch);
+
+    auto ReplaceString = [this, &result, &next, &gen] (char replace, const RuleVector& vector, bool check) {
+        if(vector.empty() || !check) return;
+        // 결과 길이의 상한만큼 미리 잡아서 arena에 버려지는 버퍼를 줄임
+        size_t count = std::count(result.begin(), result.end(), replace);
+        size_t maxLength = 0;
+        for(auto& rule : vector)
+            maxLength = std::max(maxLength, rule.size());
+        size_t bound = result.size() - count + count * maxLength;
+        if(next.capacity() < bound)
+            next.reserve(std::max(bound, next.capacity() * 2));
+        next.clear();
+
+        size_t pos = 0;
+        size_t found;
+        while ((found = result.find(replace, pos)) != std::string::npos && !IsCancelled()) {
+            next.append(result, pos, found - pos);
+            if(vector.size() == 1) {
+                next.append(vector[0]);
+            }
+            else {
+                std::uniform_int_distribution<> dis(0, vector.size() - 1); // 범위 설정
+                int randomIndex = dis(gen);
+                next.append(vector[randomIndex]);
+            }
+            pos = found + 1;
+        }
+        next.append(result, pos, std::string::npos);
+        result.swap(next);
+    };
+
+    for(int i = 0; i < m_iteration; i++) {
+        bool FCheck = result.find('F') != std::string::npos;
+        bool XCheck = result.find('X') != std::string::npos;
+        bool ACheck = result.find('A') != std::string::npos;
+        bool CCheck = result.find('C') != std::string::npos;
+
+        ReplaceString('F', F, FCheck);
+        ReplaceString('X', X, XCheck);
+        ReplaceString('A', A, ACheck);
+        ReplaceString('C', C, CCheck);
+        // 진행 상황 : derive 0 ~ 0.5, interpret 0.5 ~ 1
+        SetProgress(0.5f * (i + 1) / m_iteration);
+        if(m_progress && m_progress->onIteration && i + 1 < m_iteration && !IsCancelled()) {
+            auto preview = MakeIterationTree(result, i + 1);
+            if(preview)
+                m_progress->onIteration(std::move(preview));
+        }
+    }
+
+    return std::string(result.data(), result.size());
+}
+
+// 문자열을 op 배열로 바꾼 다음 VM으로 해석 (TurtleProgram, RunTurtleProgram)
+void Tree::MakeCylinderMatrices() {
+    // op 배열과 스택은 생성이 끝나면 버리므로 arena에 할당
+    auto scratch = GetScratch();
+    TurtleProgram program(scratch);
+    CompileTurtleProgram(m_codes, program);
+
+    TurtleParams params;
+    params.angle = m_angle;
+    params.cylinderRadius = m_cylinderRadius;
+    params.cylinderHeight = m_cylinderHeight;
+    params.radiusScaling = m_radiusScaling;
+    params.heightScaling = m_heightScaling;
+    params.seed = m_seed;
+
+    // 결과는 멤버로 옮기므로 arena가 아닌 일반 vector
+    TurtleOutput output;
+    if(!RunTurtleProgram(program, params, output, scratch,
+        m_progress ? &m_progress->progress : nullptr, m_cancel))
+        return;
+    m_cylinderVector = std::move(output.cylinderMatrices);
+    m_leafVector = std::move(output.leafMatrices);
+    m_skeleton = std::move(output.skeleton);
+}
+
+void Tree::Move(float xCoord, float zCoord) {
+    m_xCoord = xCoord;
+    m_zCoord = zCoord;
+}
+
+bool Tree::ExportObj(std::ofstream& out, const std::string& material) const {
+    if (!out.is_open()) {
+        SPDLOG_ERROR("Failed to open file : {}", std::to_string(out.tellp()));
+        return false;
+    }
+
+    int stride = m_logMesh.vertices.size();
+    auto& modelVertex = m_logMesh.vertices;
+    // 양자화한 파일에서 불러온 나무도 같은 방법으로 하나씩 복원
+    auto cylinders = GetCylinderTransforms();
+    auto leaves = GetLeafTransforms();
+    auto& modelIndex = m_logMesh.indices;
+
+    std::vector<std::tuple<float, float, float>> v;
+    std::vector<std::tuple<float, float>> vt;
+    std::vector<std::tuple<float, float, float>> vn;
+    std::vector<std::tuple<int, int, int>> f;
+
+    // export는 배치 위치를 적용한 world 좌표
+    auto placement = GetPlacement();
+    for(int i=0; i<cylinders.count; i++) {
+        int start = stride * i;
+        // vertex positions
+        auto matrix = placement * cylinders.Get(i) * glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, -1.0f * m_cylinderHeight, 0.0f));
+        for (const auto& vertex : modelVertex) {
+            auto vertexAffine = glm::vec4(vertex.position.x, vertex.position.y, vertex.position.z, 1);
+            auto normalAffine = glm::vec4(vertex.normal.x, vertex.normal.y, vertex.normal.z, 0);
+            vertexAffine = matrix * vertexAffine;
+            normalAffine = matrix * normalAffine;
+
+            v.push_back(std::tuple<float, float, float>(vertexAffine.x, vertexAffine.y, vertexAffine.z));
+            vt.push_back(std::tuple<float, float>(vertex.texCoord.x, vertex.texCoord.y));
+            vn.push_back(std::tuple<float, float, float>(normalAffine.x, normalAffine.y, normalAffine.z));
+        }
+
+        // faces using indices
+        size_t indexCount = modelIndex.size();
+        for (size_t j = 0; j < indexCount; j += 3) {
+            uint32_t index1 = modelIndex[j] + start + 1;
+            uint32_t index2 = modelIndex[j+1] + start + 1;
+            uint32_t index3 = modelIndex[j+2] + start + 1;
+
+            f.push_back(std::tuple<int, int, int>(index1, index2, index3));
+        }
+    }
+
+    out << "# tree generator\n\n";
+    out << "# material\n";
+    out << "mtllib ./" + material + ".mtl\n";
+
+    out << "o Cylinder\n";
+    out << "# vertex coordinates\n";
+    for(int i=0; i<v.size(); i++) {
+        out << "v " << std::get<0>(v[i]) << " " << std::get<1>(v[i]) << " " << std::get<2>(v[i]) << "\n";
+    }
+
+    out << "\n# texture coordinates\n";
+    for(int i=0; i<vt.size(); i++) {
+        out << "vt " << std::get<0>(vt[i]) << " " << std::get<1>(vt[i]) << "\n";
+    }
+
+    out << "\n# normal coordinates\n";
+    for(int i=0; i<vn.size(); i++) {
+        out << "vn " << std::get<0>(vn[i]) << " " << std::get<1>(vn[i]) << " " << std::get<2>(vn[i]) << "\n";
+    }
+
+    out << "\n# face\n";
+    out << "usemtl Tree\n";
+    for(int i=0; i<f.size(); i++) {
+        out << "f "
+                << std::get<0>(f[i]) << "/" << std::get<0>(f[i]) << "/" << std::get<0>(f[i]) << " "
+                << std::get<1>(f[i]) << "/" << std::get<1>(f[i]) << "/" << std::get<1>(f[i]) << " "
+                << std::get<2>(f[i]) << "/" << std::get<2>(f[i]) << "/" << std::get<2>(f[i])
+                << "\n";
+    }
+
+    v.clear();
+    vt.clear();
+    vn.clear();
+    f.clear();
+
+    if(m_isSphere) {
+        auto& sphereVertex = m_sphereMesh.vertices;
+        auto& sphereIndex = m_sphereMesh.indices;
+        int sphereStart = stride * cylinders.count;
+
+        int sphereStride = m_sphereMesh.vertices.size();
+        for(int i = 0; i < leaves.count; i++) {
+            int start = sphereStride * i;
+            // vertex positions
+            auto matrix = placement * leaves.Get(i);
+            for (const auto& vertex : sphereVertex) {
+                auto vertexAffine = glm::vec4(vertex.position.x, vertex.position.y, vertex.position.z, 1);
+                auto normalAffine = glm::vec4(vertex.normal.x, vertex.normal.y, vertex.normal.z, 0);
+                vertexAffine = matrix * vertexAffine;
+                normalAffine = matrix * normalAffine;
+
+                v.push_back(std::tuple<float, float, float>(vertexAffine.x, vertexAffine.y, vertexAffine.z));
+                vt.push_back(std::tuple<float, float>(vertex.texCoord.x, vertex.texCoord.y));
+                vn.push_back(std::tuple<float, float, float>(normalAffine.x, normalAffine.y, normalAffine.z));
+            }
+
+            // faces using indices
+            size_t indexCount = sphereIndex.size();
+            for (size_t j = 0; j < indexCount; j += 3) {
+                uint32_t index1 = sphereIndex[j] + sphereStart + start + 1;
+                uint32_t index2 = sphereIndex[j+1] + sphereStart + start + 1;
+                uint32_t index3 = sphereIndex[j+2] + sphereStart + start + 1;
+
+                f.push_back(std::tuple<int, int, int>(index1, index2, index3));
+            }
+        }
+    }
+    else {
+        auto& leafVertex = m_leafMesh.vertices;
+        auto& leafIndex = m_leafMesh.indices;
+        int leafStart = stride * cylinders.count;
+        
+        int leafStride = m_leafMesh.vertices.size();
+        for(int i = 0; i<leaves.count; i++) {
+            int start = leafStride * i;
+            // vertex positions
+            auto matrix = placement * leaves.Get(i);
+            for (const auto& vertex : leafVertex) {
+                auto vertexAffine = glm::vec4(vertex.position.x, vertex.position.y, vertex.position.z, 1);
+                auto normalAffine = glm::vec4(vertex.normal.x, vertex.normal.y, vertex.normal.z, 0);
+                vertexAffine = matrix * vertexAffine;
+                normalAffine = matrix * normalAffine;
+
+                v.push_back(std::tuple<float, float, float>(vertexAffine.x, vertexAffine.y, vertexAffine.z));
+                vt.push_back(std::tuple<float, float>(vertex.texCoord.x, vertex.texCoord.y));
+                vn.push_back(std::tuple<float, float, float>(normalAffine.x, normalAffine.y, normalAffine.z));
+            }
+
+            // faces using indices
+            size_t indexCount = leafIndex.size();
+            for (size_t j = 0; j < indexCount; j += 3) {
+                uint32_t index1 = leafIndex[j] + leafStart + start + 1;
+                uint32_t index2 = leafIndex[j+1] + leafStart + start + 1;
+                uint32_t index3 = leafIndex[j+2] + leafStart + start + 1;
+
+                f.push_back(std::tuple<int, int, int>(index1, index2, index3));
+            }
+        }
+    }
+
+    out << "\no Leaf\n";
+    out << "# vertex coordinates\n";
+    for(int i=0; i<v.size(); i++) {
+        out << "v " << std::get<0>(v[i]) << " " << std::get<1>(v[i]) << " " << std::get<2>(v[i]) << "\n";
+    }
+
+    out << "\n# texture coordinates\n";
+    for(int i=0; i<vt.size(); i++) {
+        out << "vt " << std::get<0>(vt[i]) << " " << std::get<1>(vt[i]) << "\n";
+    }
+
+    out << "\n# normal coordinates\n";
+    for(int i=0; i<vn.size(); i++) {
+        out << "vn " << std::get<0>(vn[i]) << " " << std::get<1>(vn[i]) << " " << std::get<2>(vn[i]) << "\n";
+    }
+
+    out << "\n# face\n";
+    out << "usemtl Tree\n";
+    for(int i=0; i<f.size(); i++) {
+        out << "f "
+                << std::get<0>(f[i]) << "/" << std::get<0>(f[i]) << "/" << std::get<0>(f[i]) << " "
+                << std::get<1>(f[i]) << "/" << std::get<1>(f[i]) << "/" << std::get<1>(f[i]) << " "
+                << std::get<2>(f[i]) << "/" << std::get<2>(f[i]) << "/" << std::get<2>(f[i])
+                << "\n";
+    }
+
+    return true;
+}
+
+bool Tree::ExportMtl(std::ofstream& out, const std::string& texture) const {
+    if (!out.is_open()) {
+        SPDLOG_ERROR("Failed to open file : {}", std::to_string(out.tellp()));
+        return false;
+    }
+
+    out << "# Dice.mtl\n\n";
+
+    out << "newmtl Tree\n\n";
+
+    out << "# ambient color\n";
+    out << "Ka 0.2 0.2 0.2\n\n";
+
+    out << "# diffuse color\n";
+    out << "Kd 0.7 0.7 0.7\n\n";
+
+    out << "# specular color\n";
+    out << "Ka 0.7 0.7 0.7\n\n";
+
+    out << "# Blinn-Phong shading\n";
+    out << "illum 2\n\n";
+
+    out << "# texture\n";
+    // out << "map_Kd ./" + texture + ".png\n";
+    out << "map_Kd ./tree.png\n";
+
+    return true;
+}
\ No newline at end of file
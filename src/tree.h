@@ -0,0 +1,173 @@
+#ifndef __TREE_H__
+#define __TREE_H__
+
+#include "core_common.h"
+#include "generation_arena.h"
+#include "mesh_data.h"
+#include "tree_cache.h"
+#include "tree_skeleton.h"
+#define _USE_MATH_DEFINES
+#include <math.h>
+#include <sstream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fstream>
+#include <atomic>
+#include <functional>
+
+CLASS_PTR(Tree);
+class TreeFile;
+using TreeFilePtr = std::shared_ptr<TreeFile>;
+
+// 다른 스레드에서 생성할 때 진행 상황 (0 ~ 1) 확인과 취소에 사용
+struct TreeProgress {
+    std::atomic<float> progress { 0.0f };
+    std::atomic<bool> cancel { false };
+    // 설정하면 중간 iteration (1 ~ n-1)의 나무도 완성되는 대로 전달 (생성하는 스레드에서 호출)
+    // 문자열은 이전 iteration 결과에 이어서 치환하므로 마지막 나무는 설정하지 않았을 때와 같음
+    // 중간 나무의 해석도 cancel을 확인하고, 취소되면 전달하지 않음
+    std::function<void(TreeUPtr)> onIteration;
+};
+
+/*
+가지 또는 잎 instance의 transform 배열 (행 우선 3x4 affine, instance buffer에 그대로 올림)
+양자화하지 않았으면 instance 하나가 float[12], 했으면 uint16_t[12] (값 = minimum[k] + q[k] * scale[k])
+생성한 나무는 Tree가 가진 배열, 파일에서 불러온 나무는 매핑된 메모리를 가리킴
+*/
+struct TreeTransforms {
+    static const size_t FLOAT_COUNT = 12;
+
+    size_t count { 0 };
+    const void* data { nullptr };
+    size_t size { 0 };
+    bool quantized { false };
+    const float* minimum { nullptr };
+    const float* scale { nullptr };
+
+    // index번째 instance를 float[FLOAT_COUNT]로 복원
+    void GetAffine(size_t index, float* values) const;
+    glm::mat4 Get(size_t index) const;
+    static void ToAffine(const glm::mat4& matrix, float* values);
+};
+
+/*
+GL 없이 나무 생성 (treegen_core)
+1. MakeCodes : 규칙을 iteration 만큼 적용해서 문자열 생성
+2. MakeCylinderMatrices : 문자열을 해석해서 가지 / 잎의 변환 행렬과 skeleton 생성 (뿌리가 원점인 local 좌표)
+3. 가지, 잎 mesh 데이터와 instance transform 배열 생성 및 OBJ / MTL export
+화면에 그리는 부분은 LSystem
+*/
+// "이동"에 사용되는 문자 : F, X, A, C
+class Tree {
+public:
+    // seed를 지정하지 않으면 random_device로 정함
+    static const uint32_t RANDOM_SEED = UINT32_MAX;
+
+    // std::vector {cylinderRadius, cylinderHeight, leafRadius, leafHeight, radiusScaling, heightScaling}
+    // progress를 넘기면 진행 상황을 기록하고, cancel이 설정되면 중간에 멈추고 nullptr 반환
+    // arena를 넘기면 생성 중의 임시 데이터를 여기에 할당 (생성이 끝날 때까지 다른 생성은 대기)
+    // storeInCache가 false이거나 seed가 RANDOM_SEED면 캐시에 저장하지 않음 (다시 쓰이지 않는 나무)
+    static TreeUPtr Create(std::string axiom, std::string rules, const std::vector<float>& treeParam, float angle, int iteration,
+        bool sphere = false, float xCoord = 0.0f, float zCoord = 0.0f, uint32_t seed = RANDOM_SEED,
+        TreeProgress* progress = nullptr, GenerationArena* arena = nullptr, bool storeInCache = true);
+    // 저장해둔 나무 파일에서 생성 (문자열 생성, 해석 없이 매핑된 transform과 skeleton을 복사하지 않고 사용)
+    static TreeUPtr CreateFromFile(TreeFilePtr file);
+    // 설정하면 Create에서 캐시를 먼저 확인하고, 없으면 생성 후 저장 (nullptr이면 사용 안 함)
+    static void SetCache(TreeCachePtr cache);
+    static TreeCachePtr GetCache();
+    // 실제로 생성하지 않고 규칙만으로 계산한 생성 + export 메모리 사용량의 상한 (bytes)
+    static size_t EstimateMemoryUsage(const std::string& axiom, const std::string& rules, int iteration, bool sphere);
+    const std::string& GetAxiom() const { return m_axiom; }
+    const std::string& GetRules() const { return m_rules; }
+    // 파일에서 불러온 나무는 비어있음
+    const std::string& GetCodes() const { return m_codes; }
+    bool isEmpty() const { return GetCylinderTransforms().count == 0 && GetLeafTransforms().count == 0; }
+    // 배치 위치만 바꿈 (다시 해석하지 않음), 그릴 때 GetPlacement를 곱함
+    void Move(float xCoord, float zCoord);
+    bool ExportObj(std::ofstream& out, const std::string& material) const;
+    bool ExportMtl(std::ofstream& out, const std::string& texture) const;
+
+    TreeTransforms GetCylinderTransforms() const;
+    TreeTransforms GetLeafTransforms() const;
+    // 파일에서 불러온 나무는 비어있음 (GetFile의 배열 사용)
+    const TreeSkeleton& GetSkeleton() const { return m_skeleton; }
+    const TreeFile* GetFile() const { return m_file.get(); }
+    const MeshData& GetLogMesh() const { return m_logMesh; }
+    const MeshData& GetLeafMesh() const { return m_leafMesh; }
+    const MeshData& GetSphereMesh() const { return m_sphereMesh; }
+    std::vector<float> GetTreeParam() const;
+    float GetAngle() const { return m_angle; }
+    float GetXCoord() const { return m_xCoord; }
+    float GetZCoord() const { return m_zCoord; }
+    // local 좌표 -> world 좌표 (GetCylinderTransforms, GetLeafTransforms, GetSkeleton 앞에 곱함)
+    glm::mat4 GetPlacement() const { return glm::translate(glm::mat4(1.0f), glm::vec3(m_xCoord, 0.0f, m_zCoord)); }
+    float GetCylinderHeight() const { return m_cylinderHeight; }
+    bool IsSphere() const { return m_isSphere; }
+    int GetIteration() const { return m_iteration; }
+    uint32_t GetSeed() const { return m_seed; }
+
+    // Init에서 단계별로 걸린 시간 (ms), 캐시에서 불러온 경우 derive / interpret는 0
+    // bake : mesh 데이터 + instance transform 배열 생성 (GL 업로드 직전까지)
+    struct Timing {
+        double derive { 0.0 };
+        double interpret { 0.0 };
+        double bake { 0.0 };
+    };
+    const Timing& GetTiming() const { return m_timing; }
+
+private:
+    Tree() {};
+    bool Init(std::string axiom, std::string rules, const std::vector<float>& treeParam, float angle, int iteration,
+        bool sphere, float xCoord, float zCoord, uint32_t seed, TreeProgress* progress, GenerationArena* arena,
+        bool storeInCache);
+    bool SetParameters(const std::vector<float>& treeParam);
+    bool IsCancelled() const { return m_cancel && *m_cancel; }
+    void SetProgress(float progress) { if (m_progress) m_progress->progress = progress; }
+    std::pmr::memory_resource* GetScratch() const { return m_scratch ? m_scratch : std::pmr::get_default_resource(); }
+    std::string MakeCodes();
+    TreeUPtr MakeIterationTree(std::string_view codes, int iteration) const;
+    void MakeMeshes();
+    void MakeCylinderMatrices();
+    void MakeInstanceData();
+
+    MeshData m_logMesh;
+    MeshData m_leafMesh;
+    MeshData m_sphereMesh;
+
+    // 해석 결과, MakeInstanceData에서 m_cylinderAffine / m_leafAffine으로 바꾼 뒤 비움
+    std::vector<glm::mat4> m_cylinderVector;
+    std::vector<glm::mat4> m_leafVector;
+    std::vector<float> m_cylinderAffine;
+    std::vector<float> m_leafAffine;
+    TreeSkeleton m_skeleton;
+    // 파일에서 불러온 나무는 transform과 skeleton 대신 매핑된 파일을 가지고 있음
+    TreeFilePtr m_file;
+    std::string m_axiom;
+    std::string m_rules;
+
+    float m_cylinderRadius;
+    float m_cylinderHeight;
+    float m_leafRadius;
+    float m_leafHeight;
+    float m_radiusScaling;
+    float m_heightScaling;
+
+    float m_angle;
+    int m_iteration;
+    bool m_isSphere;
+    uint32_t m_seed;
+
+    float m_xCoord;
+    float m_zCoord;
+
+    std::string m_codes;
+    Timing m_timing;
+    // Init 동안만 설정됨 (중간 iteration 나무는 m_progress 없이 m_cancel만 같이 사용)
+    TreeProgress* m_progress { nullptr };
+    const std::atomic<bool>* m_cancel { nullptr };
+    std::pmr::memory_resource* m_scratch { nullptr };
+};
+
+#endif // __TREE_H__
\ No newline at end of file
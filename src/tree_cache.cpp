@@ -0,0 +1,315 @@
+#include "tree_cache.h"
+#include "mapped_file.h"
+#include <cstring>
+#include <sstream>
+
+namespace {
+
+const char CACHE_MAGIC[4] = { 'T', 'G', 'C', 'H' };
+const char* CACHE_EXTENSION = ".tree";
+
+struct CacheFileHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t canonicalSize;
+    uint64_t codesSize;
+    uint64_t cylinderCount;
+    uint64_t leafCount;
+    uint64_t checksum; // header 뒤의 모든 데이터의 해시
+};
+
+// 나무의 행렬은 모두 affine이므로 마지막 행을 빼고 12개만 저장
+const size_t MATRIX_FLOAT_COUNT = 12;
+// skeleton은 segment 수 = 가지 행렬 수, leafSegment 수 = 잎 행렬 수라서 개수는 따로 저장하지 않음
+const size_t SEGMENT_SIZE = sizeof(int32_t) + 2 * sizeof(glm::vec3) + 2 * sizeof(float) + sizeof(uint16_t);
+const size_t LEAF_SEGMENT_SIZE = sizeof(int32_t);
+
+void AppendMatrices(std::string& out, const std::vector<glm::mat4>& matrices) {
+    size_t offset = out.size();
+    out.resize(offset + matrices.size() * MATRIX_FLOAT_COUNT * sizeof(float));
+    float* dst = (float*)(out.data() + offset);
+    for (auto& m : matrices) {
+        for (int c = 0; c < 4; c++) {
+            for (int r = 0; r < 3; r++)
+                *dst++ = m[c][r];
+        }
+    }
+}
+
+void ReadMatrices(const char* src, size_t count, std::vector<glm::mat4>& matrices) {
+    matrices.resize(count);
+    for (auto& m : matrices) {
+        float values[MATRIX_FLOAT_COUNT];
+        memcpy(values, src, sizeof(values));
+        src += sizeof(values);
+        for (int c = 0; c < 4; c++) {
+            for (int r = 0; r < 3; r++)
+                m[c][r] = values[c * 3 + r];
+            m[c][3] = c == 3 ? 1.0f : 0.0f;
+        }
+    }
+}
+
+void AppendValue(std::string& out, const void* data, size_t size) {
+    out.append((const char*)data, size);
+}
+
+template <typename T>
+void AppendArray(std::string& out, const std::vector<T>& values) {
+    AppendValue(out, values.data(), values.size() * sizeof(T));
+}
+
+template <typename T>
+const char* ReadArray(const char* src, size_t count, std::vector<T>& values) {
+    values.resize(count);
+    memcpy(values.data(), src, count * sizeof(T));
+    return src + count * sizeof(T);
+}
+
+void AppendSkeleton(std::string& out, const TreeSkeleton& skeleton) {
+    AppendArray(out, skeleton.parent);
+    AppendArray(out, skeleton.start);
+    AppendArray(out, skeleton.end);
+    AppendArray(out, skeleton.radius);
+    AppendArray(out, skeleton.length);
+    AppendArray(out, skeleton.depth);
+    AppendArray(out, skeleton.leafSegment);
+}
+
+void ReadSkeleton(const char* src, size_t segmentCount, size_t leafCount, TreeSkeleton& skeleton) {
+    src = ReadArray(src, segmentCount, skeleton.parent);
+    src = ReadArray(src, segmentCount, skeleton.start);
+    src = ReadArray(src, segmentCount, skeleton.end);
+    src = ReadArray(src, segmentCount, skeleton.radius);
+    src = ReadArray(src, segmentCount, skeleton.length);
+    src = ReadArray(src, segmentCount, skeleton.depth);
+    ReadArray(src, leafCount, skeleton.leafSegment);
+}
+
+void AppendString(std::string& out, const std::string& value) {
+    uint64_t size = value.size();
+    AppendValue(out, &size, sizeof(size));
+    out += value;
+}
+
+void AppendFloat(std::string& out, float value) {
+    // -0.0과 0.0을 같은 키로
+    if (value == 0.0f)
+        value = 0.0f;
+    AppendValue(out, &value, sizeof(value));
+}
+
+} // namespace
+
+TreeCacheUPtr TreeCache::Create(const std::string& directory, size_t maxBytes) {
+    auto cache = TreeCacheUPtr(new TreeCache());
+    if (!cache->Init(directory, maxBytes))
+        return nullptr;
+    return std::move(cache);
+}
+
+bool TreeCache::Init(const std::string& directory, size_t maxBytes) {
+    m_directory = directory;
+    m_maxBytes = maxBytes;
+
+    std::error_code error;
+    std::filesystem::create_directories(m_directory, error);
+    if (error) {
+        SPDLOG_ERROR("failed to create tree cache directory: {}", m_directory);
+        return false;
+    }
+
+    for (auto& file : std::filesystem::directory_iterator(m_directory, error)) {
+        if (!file.is_regular_file() || file.path().extension() != CACHE_EXTENSION)
+            continue;
+        uint64_t hash = 0;
+        std::istringstream ss(file.path().stem().string());
+        ss >> std::hex >> hash;
+        if (ss.fail())
+            continue;
+        FileInfo info;
+        info.size = (size_t)file.file_size();
+        info.lastUse = file.last_write_time();
+        m_files[hash] = info;
+        m_totalSize += info.size;
+    }
+    Evict();
+    SPDLOG_INFO("tree cache: {}, {} files, {:.1f} MB", m_directory, m_files.size(), m_totalSize / (1024.0 * 1024.0));
+    return true;
+}
+
+std::string TreeCache::Canonicalize(const std::string& axiom, const std::string& rules,
+    const std::vector<float>& treeParam, float angle, int iteration, uint32_t seed) {
+
+    std::string out;
+    uint32_t version = VERSION;
+    AppendValue(out, &version, sizeof(version));
+    AppendString(out, axiom);
+
+    // MakeCodes가 쓰지 않는 줄 ('='이 없는 줄)과 줄 끝의 \r (MakeCodes에서도 버림)은 결과에 영향이 없으므로 제외
+    std::string canonicalRules;
+    std::istringstream ss(rules);
+    std::string line;
+    while (std::getline(ss, line, '\n')) {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (line.find('=') == std::string::npos)
+            continue;
+        canonicalRules += line;
+        canonicalRules += '\n';
+    }
+    AppendString(out, canonicalRules);
+
+    uint32_t paramCount = (uint32_t)treeParam.size();
+    AppendValue(out, &paramCount, sizeof(paramCount));
+    for (auto value : treeParam)
+        AppendFloat(out, value);
+    AppendFloat(out, angle);
+    AppendValue(out, &iteration, sizeof(iteration));
+    // 행렬은 local 좌표라 배치 위치 (xCoord, zCoord)는 결과에 영향이 없음
+    AppendValue(out, &seed, sizeof(seed));
+    return out;
+}
+
+uint64_t TreeCache::Hash(const void* data, size_t size) {
+    return HashBytes(data, size);
+}
+
+std::string TreeCache::GetPath(uint64_t hash) const {
+    return fmt::format("{}/{:016x}{}", m_directory, hash, CACHE_EXTENSION);
+}
+
+bool TreeCache::Load(const std::string& canonical, TreeCacheEntry& entry) {
+    uint64_t hash = Hash(canonical.data(), canonical.size());
+    std::string path = GetPath(hash);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_files.find(hash) == m_files.end()) {
+            // 같은 디렉토리를 쓰는 다른 프로세스 (treegen_batch 등)가 저장했을 수 있으므로 디스크에서 확인
+            std::error_code error;
+            auto size = std::filesystem::file_size(path, error);
+            if (error) {
+                m_missCount++;
+                return false;
+            }
+            FileInfo info;
+            info.size = (size_t)size;
+            info.lastUse = std::filesystem::file_time_type::clock::now();
+            m_files[hash] = info;
+            m_totalSize += info.size;
+        }
+    }
+
+    auto file = MappedFile::Open(path);
+    bool valid = file && file->GetSize() >= sizeof(CacheFileHeader);
+    CacheFileHeader header;
+    if (valid) {
+        memcpy(&header, file->GetData(), sizeof(header));
+        size_t payloadSize = file->GetSize() - sizeof(header);
+        const char* payload = file->GetData() + sizeof(header);
+        size_t matrixSize = MATRIX_FLOAT_COUNT * sizeof(float);
+        valid = memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) == 0 && header.version == VERSION &&
+            header.canonicalSize == canonical.size() &&
+            payloadSize == header.canonicalSize + header.codesSize + (header.cylinderCount + header.leafCount) * matrixSize +
+                header.cylinderCount * SEGMENT_SIZE + header.leafCount * LEAF_SEGMENT_SIZE &&
+            header.checksum == Hash(payload, payloadSize) &&
+            memcmp(payload, canonical.data(), canonical.size()) == 0;
+        if (valid) {
+            payload += header.canonicalSize;
+            entry.codes.assign(payload, header.codesSize);
+            payload += header.codesSize;
+            ReadMatrices(payload, header.cylinderCount, entry.cylinderMatrices);
+            payload += header.cylinderCount * matrixSize;
+            ReadMatrices(payload, header.leafCount, entry.leafMatrices);
+            payload += header.leafCount * matrixSize;
+            ReadSkeleton(payload, header.cylinderCount, header.leafCount, entry.skeleton);
+        }
+    }
+    file.reset();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_files.find(hash);
+    if (!valid) {
+        // 깨졌거나 다른 버전의 파일은 삭제
+        SPDLOG_ERROR("invalid tree cache file: {}", path);
+        std::error_code error;
+        std::filesystem::remove(path, error);
+        if (it != m_files.end()) {
+            m_totalSize -= it->second.size;
+            m_files.erase(it);
+        }
+        m_missCount++;
+        return false;
+    }
+
+    // 사용 시간을 갱신해서 다른 세션에서도 LRU 순서가 유지되도록 함
+    auto now = std::filesystem::file_time_type::clock::now();
+    std::error_code error;
+    std::filesystem::last_write_time(path, now, error);
+    if (it != m_files.end())
+        it->second.lastUse = now;
+    m_hitCount++;
+    return true;
+}
+
+void TreeCache::Store(const std::string& canonical, const std::string& codes,
+    const std::vector<glm::mat4>& cylinderMatrices, const std::vector<glm::mat4>& leafMatrices,
+    const TreeSkeleton& skeleton) {
+    if (skeleton.GetSegmentCount() != cylinderMatrices.size() || skeleton.GetLeafCount() != leafMatrices.size())
+        return;
+
+    std::string payload;
+    payload.reserve(canonical.size() + codes.size() +
+        (cylinderMatrices.size() + leafMatrices.size()) * MATRIX_FLOAT_COUNT * sizeof(float) +
+        cylinderMatrices.size() * SEGMENT_SIZE + leafMatrices.size() * LEAF_SEGMENT_SIZE);
+    payload += canonical;
+    payload += codes;
+    AppendMatrices(payload, cylinderMatrices);
+    AppendMatrices(payload, leafMatrices);
+    AppendSkeleton(payload, skeleton);
+
+    size_t fileSize = sizeof(CacheFileHeader) + payload.size();
+    if (fileSize > m_maxBytes)
+        return;
+
+    CacheFileHeader header;
+    memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = VERSION;
+    header.canonicalSize = canonical.size();
+    header.codesSize = codes.size();
+    header.cylinderCount = cylinderMatrices.size();
+    header.leafCount = leafMatrices.size();
+    header.checksum = Hash(payload.data(), payload.size());
+
+    uint64_t hash = Hash(canonical.data(), canonical.size());
+    std::string path = GetPath(hash);
+    if (!WriteFileAtomic(path, { std::string_view((const char*)&header, sizeof(header)), payload }))
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& info = m_files[hash];
+    m_totalSize = m_totalSize - info.size + fileSize;
+    info.size = fileSize;
+    info.lastUse = std::filesystem::file_time_type::clock::now();
+    Evict();
+}
+
+size_t TreeCache::GetTotalSize() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_totalSize;
+}
+
+// m_mutex를 잡은 상태에서 호출
+void TreeCache::Evict() {
+    while (m_totalSize > m_maxBytes && !m_files.empty()) {
+        auto oldest = m_files.begin();
+        for (auto it = m_files.begin(); it != m_files.end(); ++it) {
+            if (it->second.lastUse < oldest->second.lastUse)
+                oldest = it;
+        }
+        std::error_code error;
+        std::filesystem::remove(GetPath(oldest->first), error);
+        m_totalSize -= oldest->second.size;
+        m_files.erase(oldest);
+    }
+}
\ No newline at end of file
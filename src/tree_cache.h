@@ -0,0 +1,69 @@
+#ifndef __TREE_CACHE_H__
+#define __TREE_CACHE_H__
+
+#include "core_common.h"
+#include "tree_skeleton.h"
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// 캐시에 저장하는 생성 결과 (mesh는 파라미터로 바로 만들 수 있으므로 저장하지 않음)
+struct TreeCacheEntry {
+    std::string codes;
+    std::vector<glm::mat4> cylinderMatrices;
+    std::vector<glm::mat4> leafMatrices;
+    TreeSkeleton skeleton;
+};
+
+/*
+생성 결과를 디스크에 저장하는 캐시
+1. 입력(axiom, rules, treeParam, angle, iteration, 위치, seed)을 정규화한 바이트열의 해시가 파일 이름
+2. 파일에는 정규화한 입력도 같이 저장해서 해시 충돌이면 사용하지 않음
+3. 전체 크기가 maxBytes를 넘으면 가장 오래 사용하지 않은 파일부터 삭제 (파일 수정 시간 기준)
+여러 스레드에서 같이 사용 가능
+*/
+CLASS_PTR(TreeCache)
+class TreeCache {
+public:
+    // 파일 형식이나 생성 방식(MakeCodes, MakeCylinderMatrices)이 바뀌면 올려서 이전 캐시를 무효화
+    static const uint32_t VERSION = 5;
+
+    static TreeCacheUPtr Create(const std::string& directory, size_t maxBytes);
+
+    static std::string Canonicalize(const std::string& axiom, const std::string& rules,
+        const std::vector<float>& treeParam, float angle, int iteration, uint32_t seed);
+    // HashBytes (FNV-1a 64bit)
+    static uint64_t Hash(const void* data, size_t size);
+
+    bool Load(const std::string& canonical, TreeCacheEntry& entry);
+    void Store(const std::string& canonical, const std::string& codes,
+        const std::vector<glm::mat4>& cylinderMatrices, const std::vector<glm::mat4>& leafMatrices,
+        const TreeSkeleton& skeleton);
+
+    size_t GetTotalSize() const;
+    size_t GetHitCount() const { return m_hitCount; }
+    size_t GetMissCount() const { return m_missCount; }
+
+private:
+    TreeCache() {}
+    bool Init(const std::string& directory, size_t maxBytes);
+    std::string GetPath(uint64_t hash) const;
+    void Evict();
+
+    struct FileInfo {
+        size_t size;
+        std::filesystem::file_time_type lastUse;
+    };
+
+    std::string m_directory;
+    size_t m_maxBytes { 0 };
+    mutable std::mutex m_mutex;
+    std::unordered_map<uint64_t, FileInfo> m_files;
+    size_t m_totalSize { 0 };
+    std::atomic<size_t> m_hitCount { 0 };
+    std::atomic<size_t> m_missCount { 0 };
+};
+
+#endif // __TREE_CACHE_H__
\ No newline at end of file
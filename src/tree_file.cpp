@@ -0,0 +1,292 @@
+#include "tree_file.h"
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+const char TREE_MAGIC[4] = { 'T', 'G', 'T', 'R' };
+// 매핑된 주소에서 배열을 바로 사용하므로 section 시작 위치를 정렬
+const size_t SECTION_ALIGNMENT = 16;
+const uint32_t TREE_PARAM_COUNT = 6;
+const uint32_t FLAG_QUANTIZED = 1;
+const uint32_t MAX_SECTION_COUNT = 64;
+
+enum class SectionType : uint32_t {
+    Axiom = 0,
+    Rules,
+    Parent,
+    Start,
+    End,
+    Radius,
+    Depth,
+    Length,
+    LeafSegment,
+    CylinderTransforms,
+    LeafTransforms,
+    Count,
+};
+
+struct TreeFileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t flags;
+    uint32_t sectionCount;
+    uint32_t seed;
+    int32_t iteration;
+    uint32_t sphere;
+    float angle;
+    float xCoord;
+    float zCoord;
+    float treeParam[TREE_PARAM_COUNT];
+};
+
+struct TreeSectionEntry {
+    uint32_t type;
+    uint32_t elementSize;
+    uint64_t count;
+    uint64_t offset; // 파일 처음부터
+    uint64_t size;
+};
+
+// 양자화한 transform section 앞에 붙는 복원 값
+struct QuantizeRange {
+    float minimum[TreeFile::TRANSFORM_FLOAT_COUNT];
+    float scale[TreeFile::TRANSFORM_FLOAT_COUNT];
+};
+
+size_t AlignOffset(size_t offset) {
+    return (offset + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
+}
+
+// section 하나 (data는 Write가 끝날 때까지 살아있어야 함)
+struct SectionSource {
+    SectionType type;
+    uint32_t elementSize;
+    size_t count;
+    std::string storage;
+    const void* data { nullptr };
+    size_t size { 0 };
+};
+
+template <typename T>
+SectionSource ArraySection(SectionType type, const T* data, size_t count) {
+    SectionSource section { type, (uint32_t)sizeof(T), count };
+    section.data = data;
+    section.size = count * sizeof(T);
+    return section;
+}
+
+template <typename T>
+SectionSource ArraySection(SectionType type, Span<const T> array) {
+    return ArraySection(type, array.data(), array.size());
+}
+
+SectionSource TransformSection(SectionType type, const TreeTransforms& transforms, bool quantize) {
+    const size_t floatCount = TreeFile::TRANSFORM_FLOAT_COUNT;
+    SectionSource section { type, 0, transforms.count };
+    // 형식이 같으면 (양자화하지 않은 나무를 그대로 저장) 복사 없이 사용
+    if (!quantize && !transforms.quantized) {
+        section.elementSize = (uint32_t)(floatCount * sizeof(float));
+        section.data = transforms.data;
+        section.size = transforms.size;
+        return section;
+    }
+
+    std::vector<float> values(transforms.count * floatCount);
+    for (size_t i = 0; i < transforms.count; i++)
+        transforms.GetAffine(i, values.data() + i * floatCount);
+    if (!quantize) {
+        section.elementSize = (uint32_t)(floatCount * sizeof(float));
+        section.storage.assign((const char*)values.data(), values.size() * sizeof(float));
+    }
+    else {
+        // 성분마다 범위를 구해서 uint16으로 나눔
+        QuantizeRange range;
+        for (size_t k = 0; k < floatCount; k++) {
+            float minValue = values.empty() ? 0.0f : values[k];
+            float maxValue = minValue;
+            for (size_t i = 0; i < transforms.count; i++) {
+                minValue = std::min(minValue, values[i * floatCount + k]);
+                maxValue = std::max(maxValue, values[i * floatCount + k]);
+            }
+            range.minimum[k] = minValue;
+            range.scale[k] = (maxValue - minValue) / (float)UINT16_MAX;
+        }
+        std::vector<uint16_t> quantized(values.size());
+        for (size_t i = 0; i < values.size(); i++) {
+            size_t k = i % floatCount;
+            float q = range.scale[k] > 0.0f ? (values[i] - range.minimum[k]) / range.scale[k] : 0.0f;
+            quantized[i] = (uint16_t)std::min(std::max(std::lround(q), 0L), (long)UINT16_MAX);
+        }
+        section.elementSize = (uint32_t)(floatCount * sizeof(uint16_t));
+        section.storage.assign((const char*)&range, sizeof(range));
+        section.storage.append((const char*)quantized.data(), quantized.size() * sizeof(uint16_t));
+    }
+    section.data = section.storage.data();
+    section.size = section.storage.size();
+    return section;
+}
+
+} // namespace
+
+bool TreeFile::Write(const std::string& path, const Tree& tree, bool quantize) {
+    auto& axiom = tree.GetAxiom();
+    auto& rules = tree.GetRules();
+    auto treeParam = tree.GetTreeParam();
+
+    TreeFileHeader header;
+    memcpy(header.magic, TREE_MAGIC, sizeof(TREE_MAGIC));
+    header.version = VERSION;
+    header.flags = quantize ? FLAG_QUANTIZED : 0;
+    header.seed = tree.GetSeed();
+    header.iteration = tree.GetIteration();
+    header.sphere = tree.IsSphere() ? 1 : 0;
+    header.angle = tree.GetAngle();
+    header.xCoord = tree.GetXCoord();
+    header.zCoord = tree.GetZCoord();
+    for (uint32_t i = 0; i < TREE_PARAM_COUNT; i++)
+        header.treeParam[i] = i < treeParam.size() ? treeParam[i] : 0.0f;
+
+    std::vector<SectionSource> sections;
+    sections.push_back(ArraySection(SectionType::Axiom, axiom.data(), axiom.size()));
+    sections.push_back(ArraySection(SectionType::Rules, rules.data(), rules.size()));
+    // 파일에서 불러온 나무는 skeleton이 매핑된 배열에 있음
+    auto file = tree.GetFile();
+    auto& skeleton = tree.GetSkeleton();
+    sections.push_back(ArraySection(SectionType::Parent, file ? file->GetParent() : Span<const int32_t>(skeleton.parent)));
+    sections.push_back(ArraySection(SectionType::Start, file ? file->GetStart() : Span<const glm::vec3>(skeleton.start)));
+    sections.push_back(ArraySection(SectionType::End, file ? file->GetEnd() : Span<const glm::vec3>(skeleton.end)));
+    sections.push_back(ArraySection(SectionType::Radius, file ? file->GetRadius() : Span<const float>(skeleton.radius)));
+    sections.push_back(ArraySection(SectionType::Depth, file ? file->GetDepth() : Span<const uint16_t>(skeleton.depth)));
+    sections.push_back(ArraySection(SectionType::Length, file ? file->GetLength() : Span<const float>(skeleton.length)));
+    sections.push_back(ArraySection(SectionType::LeafSegment, file ? file->GetLeafSegment() : Span<const int32_t>(skeleton.leafSegment)));
+    sections.push_back(TransformSection(SectionType::CylinderTransforms, tree.GetCylinderTransforms(), quantize));
+    sections.push_back(TransformSection(SectionType::LeafTransforms, tree.GetLeafTransforms(), quantize));
+    header.sectionCount = (uint32_t)sections.size();
+
+    std::vector<TreeSectionEntry> entries(sections.size());
+    size_t offset = sizeof(header) + entries.size() * sizeof(TreeSectionEntry);
+    for (size_t i = 0; i < sections.size(); i++) {
+        offset = AlignOffset(offset);
+        entries[i].type = (uint32_t)sections[i].type;
+        entries[i].elementSize = sections[i].elementSize;
+        entries[i].count = sections[i].count;
+        entries[i].offset = offset;
+        entries[i].size = sections[i].size;
+        offset += sections[i].size;
+    }
+
+    std::string out(offset, '\0');
+    memcpy(&out[0], &header, sizeof(header));
+    memcpy(&out[sizeof(header)], entries.data(), entries.size() * sizeof(TreeSectionEntry));
+    for (size_t i = 0; i < sections.size(); i++) {
+        if (sections[i].size > 0)
+            memcpy(&out[entries[i].offset], sections[i].data, sections[i].size);
+    }
+    return WriteFileAtomic(path, { out });
+}
+
+TreeFileUPtr TreeFile::Open(const std::string& path) {
+    auto file = MappedFile::Open(path);
+    if (!file)
+        return nullptr;
+    auto treeFile = TreeFileUPtr(new TreeFile());
+    if (!treeFile->Parse(file->GetData(), file->GetSize(), path))
+        return nullptr;
+    treeFile->m_file = std::move(file);
+    return std::move(treeFile);
+}
+
+bool TreeFile::Parse(const char* data, size_t size, const std::string& path) {
+    TreeFileHeader header;
+    bool valid = size >= sizeof(header);
+    if (valid) {
+        memcpy(&header, data, sizeof(header));
+        valid = memcmp(header.magic, TREE_MAGIC, sizeof(TREE_MAGIC)) == 0 && header.version == VERSION &&
+            header.sectionCount <= MAX_SECTION_COUNT &&
+            size >= sizeof(header) + header.sectionCount * sizeof(TreeSectionEntry);
+    }
+
+    // 모르는 section은 건너뜀, 필요한 section은 모두 있어야 함
+    TreeSectionEntry found[(size_t)SectionType::Count] = {};
+    bool exists[(size_t)SectionType::Count] = {};
+    for (uint32_t i = 0; valid && i < header.sectionCount; i++) {
+        TreeSectionEntry entry;
+        memcpy(&entry, data + sizeof(header) + i * sizeof(entry), sizeof(entry));
+        valid = entry.offset <= size && entry.size <= size - entry.offset && entry.offset % SECTION_ALIGNMENT == 0;
+        if (valid && entry.type < (uint32_t)SectionType::Count) {
+            found[entry.type] = entry;
+            exists[entry.type] = true;
+        }
+    }
+    for (size_t i = 0; valid && i < (size_t)SectionType::Count; i++)
+        valid = exists[i];
+    if (!valid) {
+        SPDLOG_ERROR("invalid tree file: {}", path);
+        return false;
+    }
+
+    // 크기가 맞지 않으면 valid만 끄고, 배열은 아래에서 개수를 확인하기 전까지 읽지 않음
+    auto GetSection = [&](SectionType type, size_t elementSize, size_t headerSize = 0) -> const char* {
+        auto& entry = found[(size_t)type];
+        if (entry.elementSize != elementSize || entry.count > entry.size ||
+            entry.size != headerSize + entry.count * elementSize)
+            valid = false;
+        return data + entry.offset;
+    };
+    auto GetCount = [&](SectionType type) {
+        return (size_t)found[(size_t)type].count;
+    };
+
+    m_axiom = std::string_view(GetSection(SectionType::Axiom, sizeof(char)), GetCount(SectionType::Axiom));
+    m_rules = std::string_view(GetSection(SectionType::Rules, sizeof(char)), GetCount(SectionType::Rules));
+    m_parent = Span<const int32_t>((const int32_t*)GetSection(SectionType::Parent, sizeof(int32_t)), GetCount(SectionType::Parent));
+    m_start = Span<const glm::vec3>((const glm::vec3*)GetSection(SectionType::Start, sizeof(glm::vec3)), GetCount(SectionType::Start));
+    m_end = Span<const glm::vec3>((const glm::vec3*)GetSection(SectionType::End, sizeof(glm::vec3)), GetCount(SectionType::End));
+    m_radius = Span<const float>((const float*)GetSection(SectionType::Radius, sizeof(float)), GetCount(SectionType::Radius));
+    m_depth = Span<const uint16_t>((const uint16_t*)GetSection(SectionType::Depth, sizeof(uint16_t)), GetCount(SectionType::Depth));
+    m_length = Span<const float>((const float*)GetSection(SectionType::Length, sizeof(float)), GetCount(SectionType::Length));
+    m_leafSegment = Span<const int32_t>((const int32_t*)GetSection(SectionType::LeafSegment, sizeof(int32_t)), GetCount(SectionType::LeafSegment));
+
+    bool quantized = (header.flags & FLAG_QUANTIZED) != 0;
+    auto ReadTransforms = [&](SectionType type, Transforms& transforms) {
+        size_t elementSize = TRANSFORM_FLOAT_COUNT * (quantized ? sizeof(uint16_t) : sizeof(float));
+        size_t headerSize = quantized ? sizeof(QuantizeRange) : 0;
+        const char* section = GetSection(type, elementSize, headerSize);
+        transforms.count = GetCount(type);
+        transforms.quantized = quantized;
+        if (quantized) {
+            auto range = (const QuantizeRange*)section;
+            transforms.minimum = range->minimum;
+            transforms.scale = range->scale;
+        }
+        transforms.data = section + headerSize;
+        transforms.size = transforms.count * elementSize;
+    };
+    ReadTransforms(SectionType::CylinderTransforms, m_cylinderTransforms);
+    ReadTransforms(SectionType::LeafTransforms, m_leafTransforms);
+
+    // skeleton은 가지 / 잎 수와 같아야 함
+    size_t segmentCount = m_cylinderTransforms.count;
+    valid = valid && m_parent.size() == segmentCount && m_start.size() == segmentCount &&
+        m_end.size() == segmentCount && m_radius.size() == segmentCount &&
+        m_depth.size() == segmentCount && m_length.size() == segmentCount &&
+        m_leafSegment.size() == m_leafTransforms.count;
+    for (size_t i = 0; valid && i < segmentCount; i++)
+        valid = m_parent[i] >= TreeSkeleton::NO_PARENT && m_parent[i] < (int32_t)i;
+    for (size_t i = 0; valid && i < m_leafSegment.size(); i++)
+        valid = m_leafSegment[i] >= TreeSkeleton::NO_PARENT && m_leafSegment[i] < (int32_t)segmentCount;
+    if (!valid) {
+        SPDLOG_ERROR("invalid tree file: {}", path);
+        return false;
+    }
+
+    m_treeParam.assign(header.treeParam, header.treeParam + TREE_PARAM_COUNT);
+    m_angle = header.angle;
+    m_iteration = header.iteration;
+    m_isSphere = header.sphere != 0;
+    m_seed = header.seed;
+    m_xCoord = header.xCoord;
+    m_zCoord = header.zCoord;
+    return true;
+}
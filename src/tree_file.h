@@ -0,0 +1,80 @@
+#ifndef __TREE_FILE_H__
+#define __TREE_FILE_H__
+
+#include "core_common.h"
+#include "mapped_file.h"
+#include "tree.h"
+#include "tree_skeleton.h"
+#include <string_view>
+#include <vector>
+
+/*
+생성한 나무를 다시 생성하지 않고 불러오기 위한 파일 (.tgtree)
+1. header (생성 입력값) + section 테이블 + section 데이터 (16바이트 정렬)
+2. section : axiom, rules, skeleton 배열들, 가지 / 잎 transform
+3. transform은 행 우선 3x4 affine (instance buffer에서 vec4 attribute 3개), 양자화하면 성분마다 uint16
+4. transform과 skeleton은 나무의 local 좌표, 배치 위치는 header의 xCoord, zCoord
+열 때는 MappedFile로 매핑만 하고, 배열은 복사 없이 매핑된 메모리를 가리킴
+Tree::CreateFromFile로 만든 나무는 이 배열을 그대로 instance buffer에 올림 (LSystem)
+*/
+CLASS_PTR(TreeFile)
+class TreeFile {
+public:
+    // 파일 형식이 바뀌면 올림
+    static const uint32_t VERSION = 4;
+    static const size_t TRANSFORM_FLOAT_COUNT = TreeTransforms::FLOAT_COUNT;
+    using Transforms = TreeTransforms;
+
+    static bool Write(const std::string& path, const Tree& tree, bool quantize = false);
+    static TreeFileUPtr Open(const std::string& path);
+
+    std::string_view GetAxiom() const { return m_axiom; }
+    std::string_view GetRules() const { return m_rules; }
+    const std::vector<float>& GetTreeParam() const { return m_treeParam; }
+    float GetAngle() const { return m_angle; }
+    int GetIteration() const { return m_iteration; }
+    bool IsSphere() const { return m_isSphere; }
+    uint32_t GetSeed() const { return m_seed; }
+    float GetXCoord() const { return m_xCoord; }
+    float GetZCoord() const { return m_zCoord; }
+    bool IsQuantized() const { return m_cylinderTransforms.quantized; }
+
+    const Transforms& GetCylinderTransforms() const { return m_cylinderTransforms; }
+    const Transforms& GetLeafTransforms() const { return m_leafTransforms; }
+
+    // TreeSkeleton과 같은 배열 (매핑된 메모리)
+    Span<const int32_t> GetParent() const { return m_parent; }
+    Span<const glm::vec3> GetStart() const { return m_start; }
+    Span<const glm::vec3> GetEnd() const { return m_end; }
+    Span<const float> GetRadius() const { return m_radius; }
+    Span<const uint16_t> GetDepth() const { return m_depth; }
+    Span<const float> GetLength() const { return m_length; }
+    Span<const int32_t> GetLeafSegment() const { return m_leafSegment; }
+
+private:
+    TreeFile() {}
+    bool Parse(const char* data, size_t size, const std::string& path);
+
+    MappedFileUPtr m_file;
+    std::string_view m_axiom;
+    std::string_view m_rules;
+    std::vector<float> m_treeParam;
+    float m_angle { 0.0f };
+    int m_iteration { 0 };
+    bool m_isSphere { false };
+    uint32_t m_seed { 0 };
+    float m_xCoord { 0.0f };
+    float m_zCoord { 0.0f };
+
+    Transforms m_cylinderTransforms;
+    Transforms m_leafTransforms;
+    Span<const int32_t> m_parent;
+    Span<const glm::vec3> m_start;
+    Span<const glm::vec3> m_end;
+    Span<const float> m_radius;
+    Span<const uint16_t> m_depth;
+    Span<const float> m_length;
+    Span<const int32_t> m_leafSegment;
+};
+
+#endif // __TREE_FILE_H__
\ No newline at end of file
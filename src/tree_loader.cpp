@@ -0,0 +1,94 @@
+#include "tree_loader.h"
+
+TreeLoaderUPtr TreeLoader::Start(std::string axiom, std::string rules, std::vector<float> treeParam, float angle,
+    int iteration, bool sphere, float xCoord, float zCoord, uint32_t seed, bool progressive, GenerationArenaPtr arena,
+    bool storeInCache) {
+    auto loader = TreeLoaderUPtr(new TreeLoader());
+    loader->m_axiom = std::move(axiom);
+    loader->m_rules = std::move(rules);
+    loader->m_treeParam = std::move(treeParam);
+    loader->m_angle = angle;
+    loader->m_iteration = iteration;
+    loader->m_sphere = sphere;
+    loader->m_xCoord = xCoord;
+    loader->m_zCoord = zCoord;
+    loader->m_seed = seed;
+    loader->m_progressive = progressive;
+    loader->m_arena = std::move(arena);
+    loader->m_storeInCache = storeInCache;
+    loader->m_worker = std::thread(&TreeLoader::Run, loader.get());
+    return std::move(loader);
+}
+
+TreeLoader::~TreeLoader() {
+    Cancel();
+    if (m_worker.joinable())
+        m_worker.join();
+}
+
+// 워커 스레드
+void TreeLoader::Run() {
+    if (m_progressive) {
+        m_progress.onIteration = [this](TreeUPtr tree) {
+            std::lock_guard<std::mutex> lock(m_previewMutex);
+            m_previewTree = std::move(tree);
+        };
+    }
+    // 한 번만 생성하므로 문자열은 Tree로 옮김
+    m_tree = Tree::Create(std::move(m_axiom), std::move(m_rules), m_treeParam, m_angle, m_iteration, m_sphere,
+        m_xCoord, m_zCoord, m_seed, &m_progress, m_arena.get(), m_storeInCache);
+    m_workerDone = true;
+}
+
+TreeLoader::State TreeLoader::Update(const LSystem* shared, bool optimizeMeshes) {
+    if (m_state != State::Generating)
+        return m_state;
+
+    TreeUPtr preview;
+    {
+        std::lock_guard<std::mutex> lock(m_previewMutex);
+        preview = std::move(m_previewTree);
+    }
+    if (!m_workerDone) {
+        // 렌더 스레드에서는 mesh만 만들면 되므로 중간 결과는 바로 GL 리소스로 변환
+        if (preview && !m_progress.cancel) {
+            int iteration = preview->GetIteration();
+            m_lsystem = LSystem::CreateFromTree(std::move(preview), shared, optimizeMeshes);
+            if (m_lsystem)
+                m_previewIteration = iteration;
+        }
+        return m_state;
+    }
+    m_worker.join();
+
+    if (m_progress.cancel) {
+        m_tree.reset();
+        m_lsystem.reset();
+        m_state = State::Cancelled;
+        return m_state;
+    }
+    if (!m_tree) {
+        m_state = State::Failed;
+        return m_state;
+    }
+    m_lsystem = LSystem::CreateFromTree(std::move(m_tree), shared, optimizeMeshes);
+    m_state = m_lsystem ? State::Done : State::Failed;
+    return m_state;
+}
+
+float TreeLoader::GetProgress() const {
+    if (m_state == State::Generating)
+        return m_progress.progress;
+    return 1.0f;
+}
+
+const char* TreeLoader::GetStatus() const {
+    if (m_progress.cancel)
+        return "cancelling";
+    switch (m_state) {
+        case State::Generating: return m_progress.progress < 0.5f ? "deriving" : "interpreting";
+        case State::Done: return "done";
+        case State::Failed: return "failed";
+        default: return "cancelled";
+    }
+}
\ No newline at end of file
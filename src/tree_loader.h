@@ -0,0 +1,72 @@
+#ifndef __TREE_LOADER_H__
+#define __TREE_LOADER_H__
+
+#include "common.h"
+#include "lsystem.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+/*
+나무 비동기 생성
+1. 워커 스레드 : Tree::Create (문자열 생성, 행렬 계산, mesh 데이터 생성, GL 호출 없음)
+2. 렌더 스레드 : Update()에서 워커가 끝났으면 LSystem::CreateFromTree로 GL 리소스 생성
+완료될 때까지 기존 나무는 그대로 그림
+progressive면 중간 iteration 나무도 완성되는 대로 TakeLSystem으로 받을 수 있음
+*/
+CLASS_PTR(TreeLoader)
+class TreeLoader {
+public:
+    enum class State { Generating, Done, Failed, Cancelled };
+
+    static TreeLoaderUPtr Start(std::string axiom, std::string rules, std::vector<float> treeParam, float angle,
+        int iteration, bool sphere = false, float xCoord = 0.0f, float zCoord = 0.0f, uint32_t seed = Tree::RANDOM_SEED,
+        bool progressive = false, GenerationArenaPtr arena = nullptr, bool storeInCache = true);
+    // 생성 중이면 취소하고 워커가 멈출 때까지 대기
+    ~TreeLoader();
+
+    // shared : 텍스쳐와 쉐이더를 같이 사용할 기존 나무 (없으면 새로 생성)
+    // optimizeMeshes : LSystem::CreateFromTree에 그대로 전달
+    State Update(const LSystem* shared, bool optimizeMeshes = true);
+    void Cancel() { m_progress.cancel = true; }
+
+    State GetState() const { return m_state; }
+    float GetProgress() const;
+    const char* GetStatus() const;
+
+    int GetPreviewIteration() const { return m_previewIteration; }
+
+    // 완성된 나무, progressive면 생성 중에는 가장 최근의 중간 결과 (없으면 nullptr)
+    LSystemUPtr TakeLSystem() { return std::move(m_lsystem); }
+
+private:
+    TreeLoader() {}
+    void Run();
+
+    std::string m_axiom;
+    std::string m_rules;
+    std::vector<float> m_treeParam;
+    float m_angle { 0.0f };
+    int m_iteration { 0 };
+    bool m_sphere { false };
+    float m_xCoord { 0.0f };
+    float m_zCoord { 0.0f };
+    uint32_t m_seed { Tree::RANDOM_SEED };
+    bool m_progressive { false };
+    bool m_storeInCache { true };
+    GenerationArenaPtr m_arena;
+    State m_state { State::Generating };
+
+    std::thread m_worker;
+    std::atomic<bool> m_workerDone { false };
+    TreeProgress m_progress;
+    TreeUPtr m_tree;
+    LSystemUPtr m_lsystem;
+
+    // 워커가 넘겨준 중간 결과, 렌더 스레드가 가져가기 전에 새 결과가 오면 교체
+    std::mutex m_previewMutex;
+    TreeUPtr m_previewTree;
+    int m_previewIteration { 0 };
+};
+
+#endif // __TREE_LOADER_H__
\ No newline at end of file
@@ -0,0 +1,27 @@
+#include "tree_preset.h"
+
+const std::vector<TreePreset>& GetTreePresets() {
+    static const std::vector<TreePreset> presets = {
+        { "ARROW_TREE", "FFA",
+            "A=F[--&&FC][++&&FC][--^FC][++^FC]\n"
+            "C=F[--<&&FC]||[++>&&FC]||[+<^^FC]||[->^^FC]" },
+        { "STOCHASTIC", "FFA",
+            "A=F++++[&&FC]++++[&&FC]++++[^FC]++++[^FC]\n"
+            "A=F----[&&FC]----[&&FC]----[^FC]----[^FC]\n"
+            "C=|F[--<&&FC]||[++>&&FFC]||[+<^^FC]||[->^^FFC]\n"
+            "C=F[--<&&FFC]||[++>&&FC]||[+<^^FFC]||[->^^FC]" },
+        { "BUSH_LIKE", "FFA",
+            "A=[C]++++[C]++++[C]\n"
+            "C=&FFA" },
+        { "BINARYTREE", "X", "X=F[<X][>X]" },
+    };
+    return presets;
+}
+
+const TreePreset* FindTreePreset(const std::string& name) {
+    for (auto& preset : GetTreePresets()) {
+        if (name == preset.name)
+            return &preset;
+    }
+    return nullptr;
+}
\ No newline at end of file
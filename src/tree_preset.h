@@ -0,0 +1,18 @@
+#ifndef __TREE_PRESET_H__
+#define __TREE_PRESET_H__
+
+#include "core_common.h"
+#include <vector>
+
+// 기본 제공 규칙 (GUI의 rule 목록, batch 도구, 벤치마크에서 공용)
+struct TreePreset {
+    const char* name;
+    const char* axiom;
+    const char* rules;
+};
+
+const std::vector<TreePreset>& GetTreePresets();
+// 없으면 nullptr
+const TreePreset* FindTreePreset(const std::string& name);
+
+#endif // __TREE_PRESET_H__
\ No newline at end of file
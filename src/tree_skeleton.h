@@ -0,0 +1,61 @@
+#ifndef __TREE_SKELETON_H__
+#define __TREE_SKELETON_H__
+
+#include "core_common.h"
+#include <vector>
+
+/*
+문자열 해석 결과의 가지 구조 (structure of arrays, 가지 하나 = segment 하나)
+MakeCylinderMatrices에서 행렬과 같은 순서로 채움 -> segment i는 GetCylinderTransforms()의 i번째
+컬링, LOD, 애니메이션, 가지치기, export 등에서 m_codes를 다시 해석하지 않고 사용
+*/
+struct TreeSkeleton {
+    static const int32_t NO_PARENT = -1;
+
+    // segment 별 (parent는 항상 자신보다 앞의 index)
+    std::vector<int32_t> parent;
+    std::vector<glm::vec3> start;
+    std::vector<glm::vec3> end;
+    std::vector<float> radius;     // 아래쪽 반지름
+    std::vector<uint16_t> depth;   // '[' 중첩 깊이 (branch order, 줄기 = 0)
+    std::vector<float> length;     // 뿌리부터 segment 끝까지 누적 길이
+
+    // 잎 별 (GetLeafTransforms()의 i번째 잎이 붙어있는 segment, 없으면 NO_PARENT)
+    std::vector<int32_t> leafSegment;
+
+    size_t GetSegmentCount() const { return parent.size(); }
+    size_t GetLeafCount() const { return leafSegment.size(); }
+
+    void Clear() {
+        parent.clear();
+        start.clear();
+        end.clear();
+        radius.clear();
+        depth.clear();
+        length.clear();
+        leafSegment.clear();
+    }
+
+    void Reserve(size_t segmentCount) {
+        parent.reserve(segmentCount);
+        start.reserve(segmentCount);
+        end.reserve(segmentCount);
+        radius.reserve(segmentCount);
+        depth.reserve(segmentCount);
+        length.reserve(segmentCount);
+    }
+
+    int32_t AddSegment(int32_t parentIndex, const glm::vec3& segmentStart, const glm::vec3& segmentEnd,
+        float segmentRadius, uint16_t segmentDepth) {
+        float accumulated = parentIndex == NO_PARENT ? 0.0f : length[parentIndex];
+        parent.push_back(parentIndex);
+        start.push_back(segmentStart);
+        end.push_back(segmentEnd);
+        radius.push_back(segmentRadius);
+        depth.push_back(segmentDepth);
+        length.push_back(accumulated + glm::length(segmentEnd - segmentStart));
+        return (int32_t)parent.size() - 1;
+    }
+};
+
+#endif // __TREE_SKELETON_H__
\ No newline at end of file
@@ -0,0 +1,135 @@
+#include "turtle_program.h"
+
+namespace {
+
+bool IsMove(char c) {
+    return c == 'F' || c == 'X' || c == 'A' || c == 'C';
+}
+
+// 같은 축으로 합칠 수 있는 회전 문자
+bool GetRotation(char c, TurtleOpCode& code) {
+    switch (c) {
+        case '+': code = TurtleOpCode::YawPlus; return true;
+        case '-': code = TurtleOpCode::YawMinus; return true;
+        case '^': code = TurtleOpCode::PitchPlus; return true;
+        case '&': code = TurtleOpCode::PitchMinus; return true;
+        case '<': code = TurtleOpCode::RollPlus; return true;
+        case '>': code = TurtleOpCode::RollMinus; return true;
+        default: return false;
+    }
+}
+
+// '[' 하나의 상태
+struct Level {
+    uint32_t matrixCount { 0 };
+    uint32_t scalingCount { 0 };
+    int32_t segment { -1 }; // '['를 만났을 때의 가지
+};
+
+} // namespace
+
+void CompileTurtleProgram(std::string_view codes, TurtleProgram& program) {
+    program.clear();
+    std::pmr::vector<Level> levels(program.get_allocator().resource());
+    levels.emplace_back();
+    int32_t segmentCount = 0;
+    int32_t currentSegment = -1;
+    size_t pendingSkip = 0;
+
+    auto Emit = [&](TurtleOp op) {
+        while (pendingSkip > UINT16_MAX) {
+            TurtleOp skip;
+            skip.code = TurtleOpCode::Skip;
+            skip.count = (uint32_t)std::min<size_t>(pendingSkip, UINT32_MAX);
+            pendingSkip -= skip.count;
+            program.push_back(skip);
+        }
+        op.skip = (uint16_t)pendingSkip;
+        pendingSkip = 0;
+        program.push_back(op);
+    };
+    // 같은 문자가 이어지는 길이
+    auto RunLength = [&](size_t i, bool (*match)(char, char)) {
+        size_t end = i + 1;
+        while (end < codes.size() && match(codes[i], codes[end]) && end - i < UINT32_MAX)
+            end++;
+        return end - i;
+    };
+    auto SameChar = [](char a, char b) { return a == b; };
+    auto BothMove = [](char a, char b) { return IsMove(b); };
+
+    size_t i = 0;
+    while (i < codes.size()) {
+        char c = codes[i];
+        auto& level = levels.back();
+        TurtleOp op;
+        if (IsMove(c)) {
+            size_t run = RunLength(i, BothMove);
+            op.code = TurtleOpCode::Move;
+            op.count = (uint32_t)run;
+            op.depth = (uint32_t)(levels.size() - 1);
+            op.segment = currentSegment;
+            Emit(op);
+            level.matrixCount += (uint32_t)run;
+            level.scalingCount += (uint32_t)run;
+            segmentCount += (int32_t)run;
+            currentSegment = segmentCount - 1;
+            i += run;
+        }
+        else if (GetRotation(c, op.code)) {
+            size_t run = RunLength(i, SameChar);
+            op.count = (uint32_t)run;
+            Emit(op);
+            level.matrixCount++;
+            i += run;
+        }
+        else if (c == '|') {
+            size_t run = RunLength(i, SameChar);
+            if (run % 2 == 0) {
+                pendingSkip += run;
+            }
+            else {
+                op.code = TurtleOpCode::TurnAround;
+                op.count = (uint32_t)run;
+                Emit(op);
+                level.matrixCount++;
+            }
+            i += run;
+        }
+        else if (c == '[') {
+            Level next;
+            next.segment = currentSegment;
+            levels.push_back(next);
+            pendingSkip++;
+            i++;
+        }
+        else if (c == ']') {
+            op.code = TurtleOpCode::Pop;
+            op.count = level.matrixCount;
+            op.scalingCount = level.scalingCount;
+            op.segment = currentSegment;
+            if (i > 0 && IsMove(codes[i - 1]))
+                op.flags |= TurtleOp::FLAG_AFTER_MOVE;
+            Emit(op);
+            // 짝이 없는 ']'는 맨 바깥 단계를 비우기만 함
+            if (levels.size() > 1) {
+                currentSegment = level.segment;
+                levels.pop_back();
+            }
+            else {
+                level = Level();
+                level.segment = currentSegment;
+            }
+            i++;
+        }
+        else {
+            pendingSkip++;
+            i++;
+        }
+    }
+    // 마지막에 남은 난수는 결과에 영향이 없으므로 버림
+    pendingSkip = 0;
+    TurtleOp end;
+    end.code = TurtleOpCode::End;
+    Emit(end);
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#ifndef __TURTLE_PROGRAM_H__
+#define __TURTLE_PROGRAM_H__
+
+#include "core_common.h"
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+/*
+생성한 문자열을 해석하기 전에 turtle 명령(op) 배열로 변환
+1. 같은 축의 연속된 회전 (++++, ^^^ 등)은 반복 수를 가진 op 하나 -> 행렬 push 한 번
+2. '|' 두 개는 서로 상쇄되므로 행렬을 만들지 않음
+3. ']'에서 되돌릴 행렬 수는 문자열만으로 정해지므로 미리 계산 ('['는 op가 없음, 빈 괄호는 잎 판정만 남음)
+4. skeleton의 parent / 잎이 붙는 segment도 미리 계산
+문자마다 뽑던 각도 난수는 op의 skip, count 만큼 같은 순서로 뽑으므로 같은 seed면 같은 나무
+*/
+enum class TurtleOpCode : uint8_t {
+    Move,       // F, X, A, C : count 개의 가지
+    YawPlus,    // + : y축 회전
+    YawMinus,   // -
+    PitchPlus,  // ^ : x축 회전 + z 이동
+    PitchMinus, // &
+    RollPlus,   // < : z축 회전 + x 이동
+    RollMinus,  // >
+    TurnAround, // | : y축 180도 (홀수 개일 때만 생성)
+    Pop,        // ]
+    Skip,       // 난수만 뽑음 (skip이 uint16 범위를 넘을 때)
+    End,        // 항상 마지막에 하나 (실행할 때 범위 확인 없이 다음 op로 넘어가기 위함)
+};
+
+struct TurtleOp {
+    static const uint8_t FLAG_AFTER_MOVE = 1; // Pop : 바로 앞 문자가 가지
+
+    TurtleOpCode code;
+    uint8_t flags { 0 };
+    uint16_t skip { 0 };   // op 전에 버리는 각도 난수 수 ('[' 등 행렬을 바꾸지 않는 문자)
+    uint32_t count { 0 };  // 반복 수 (Pop : 되돌릴 행렬 수)
+    union {
+        uint32_t depth;        // Move : '[' 중첩 깊이
+        uint32_t scalingCount; // Pop : 되돌릴 잎 크기 행렬 수
+    };
+    int32_t segment { -1 }; // Move : 첫 가지의 parent, Pop : 잎이 붙는 가지
+
+    TurtleOp() : depth(0) {}
+};
+
+using TurtleProgram = std::pmr::vector<TurtleOp>;
+
+void CompileTurtleProgram(std::string_view codes, TurtleProgram& program);
+
+#endif // __TURTLE_PROGRAM_H__
\ No newline at end of file
@@ -0,0 +1,264 @@
+#include "turtle_vm.h"
+#include <random>
+
+// GCC / Clang의 labels as values 확장 (MSVC는 switch 사용)
+#if defined(__GNUC__)
+#define TURTLE_THREADED_DISPATCH 1
+#endif
+
+namespace {
+
+// 기울일 때 회전 방향으로 밀리는 정도
+const float TILT_WEIGHT = 1.5f;
+// 가지 각도의 표준편차 (도), 각도 난수는 항상 사용
+const float ANGLE_JITTER = 4.0f;
+// 진행 상황 / 취소 확인 간격 (op 수)
+const size_t REPORT_INTERVAL = 4096;
+
+// 축 하나에 대한 회전 (glm은 열 우선, m[열][행])
+glm::mat4 RotateY(float radians) {
+    float c = cosf(radians);
+    float s = sinf(radians);
+    glm::mat4 m(1.0f);
+    m[0][0] = c;  m[0][2] = -s;
+    m[2][0] = s;  m[2][2] = c;
+    return m;
+}
+
+// x축 회전 후 z 방향으로 push * sin 만큼 이동 (^, &)
+glm::mat4 TiltX(float radians, float push) {
+    float c = cosf(radians);
+    float s = sinf(radians);
+    float z = push * s;
+    glm::mat4 m(1.0f);
+    m[1][1] = c;  m[1][2] = s;
+    m[2][1] = -s; m[2][2] = c;
+    m[3] = glm::vec4(0.0f, -s * z, c * z, 1.0f);
+    return m;
+}
+
+// z축 회전 후 -x 방향으로 push * sin 만큼 이동 (<, >)
+glm::mat4 TiltZ(float radians, float push) {
+    float c = cosf(radians);
+    float s = sinf(radians);
+    float x = -push * s;
+    glm::mat4 m(1.0f);
+    m[0][0] = c;  m[0][1] = s;
+    m[1][0] = -s; m[1][1] = c;
+    m[3] = glm::vec4(c * x, s * x, 0.0f, 1.0f);
+    return m;
+}
+
+// 실행 전에 한 번만 계산하는 상수
+struct TurtleConstants {
+    glm::mat4 move;           // 가지 하나 (축소 후 위로 이동)
+    glm::mat4 scalingInverse; // 잎 크기가 가지와 같이 줄지 않도록 보정
+    glm::mat4 leafTranslate;
+    glm::mat4 turnAround;
+    glm::vec4 segmentStart;
+    glm::vec4 segmentEnd;
+    float tiltPush;
+};
+
+void PopMatrices(std::pmr::vector<glm::mat4>& stack, uint32_t count) {
+    // 맨 아래 (시작 위치) 행렬은 남김
+    stack.resize(stack.size() - std::min<size_t>(count, stack.size() - 1));
+}
+
+template <bool Report>
+bool Run(const TurtleProgram& program, const TurtleParams& params, const TurtleConstants& k,
+    TurtleOutput& output, std::pmr::memory_resource* scratch,
+    std::atomic<float>* progress, const std::atomic<bool>* cancel) {
+    std::mt19937 gen(params.seed + 1);
+    std::normal_distribution<float> normalDistEndGen(0.0f, 0.5f);
+    std::normal_distribution<float> normalDistAngle(params.angle, ANGLE_JITTER);
+
+    // 문자마다 각도 난수를 하나씩 뽑음 (쓰지 않는 문자도 순서를 맞추기 위해 뽑음)
+    auto Discard = [&](uint32_t count) {
+        for (uint32_t i = 0; i < count; i++)
+            normalDistAngle(gen);
+    };
+    // count 번 회전한 각도의 합 (radians)
+    auto SumAngles = [&](uint32_t count) {
+        float sum = 0.0f;
+        for (uint32_t i = 0; i < count; i++)
+            sum += normalDistAngle(gen);
+        return glm::radians(sum);
+    };
+    // count 번 기울인 행렬, 각도마다 이동량이 달라서 하나씩 곱함
+    auto Tilt = [&](glm::mat4 (*tilt)(float, float), float sign, uint32_t count) {
+        glm::mat4 matrix(1.0f);
+        for (uint32_t i = 0; i < count; i++)
+            matrix = matrix * tilt(sign * glm::radians(normalDistAngle(gen)), k.tiltPush);
+        return matrix;
+    };
+
+    std::pmr::vector<glm::mat4> stack(scratch);
+    std::pmr::vector<glm::mat4> scalingStack(scratch);
+    stack.push_back(glm::mat4(1.0f));
+    scalingStack.push_back(glm::mat4(1.0f));
+    auto Push = [&](const glm::mat4& matrix) {
+        stack.push_back(stack.back() * matrix);
+    };
+
+    auto& skeleton = output.skeleton;
+    const TurtleOp* begin = program.data();
+    const TurtleOp* op = begin;
+    const size_t opCount = program.size();
+    int randomNum;
+
+#define TURTLE_REPORT() \
+    if constexpr (Report) { \
+        size_t index = (size_t)(op - begin); \
+        if (index % REPORT_INTERVAL == 0) { \
+            if (cancel && *cancel) \
+                return false; \
+            if (progress) \
+                *progress = 0.5f + 0.5f * index / opCount; \
+        } \
+    }
+
+#ifdef TURTLE_THREADED_DISPATCH
+    // TurtleOpCode 순서와 같아야 함
+    static const void* const dispatch[] = {
+        &&op_Move, &&op_YawPlus, &&op_YawMinus, &&op_PitchPlus, &&op_PitchMinus,
+        &&op_RollPlus, &&op_RollMinus, &&op_TurnAround, &&op_Pop, &&op_Skip, &&op_End,
+    };
+    static_assert(sizeof(dispatch) / sizeof(dispatch[0]) == (size_t)TurtleOpCode::End + 1, "dispatch table");
+#define TURTLE_OP(name) op_##name:
+#define TURTLE_DISPATCH() \
+    do { \
+        TURTLE_REPORT(); \
+        Discard(op->skip); \
+        goto *dispatch[(size_t)op->code]; \
+    } while (0)
+#define TURTLE_NEXT() \
+    do { \
+        op++; \
+        TURTLE_DISPATCH(); \
+    } while (0)
+
+    TURTLE_DISPATCH();
+    {
+#else
+#define TURTLE_OP(name) case TurtleOpCode::name:
+#define TURTLE_NEXT() \
+    do { \
+        op++; \
+        goto next; \
+    } while (0)
+
+    for (;;) {
+    next:
+        TURTLE_REPORT();
+        Discard(op->skip);
+        switch (op->code) {
+#endif
+
+        TURTLE_OP(Move)
+            for (uint32_t i = 0; i < op->count; i++) {
+                Discard(1);
+                Push(k.move);
+                const auto& matrix = stack.back();
+                output.cylinderMatrices.push_back(matrix);
+                skeleton.AddSegment(i == 0 ? op->segment : (int32_t)skeleton.GetSegmentCount() - 1,
+                    glm::vec3(matrix * k.segmentStart), glm::vec3(matrix * k.segmentEnd),
+                    params.cylinderRadius * glm::length(glm::vec3(matrix[0])),
+                    (uint16_t)std::min<uint32_t>(op->depth, UINT16_MAX));
+                scalingStack.push_back(scalingStack.back() * k.scalingInverse);
+            }
+            TURTLE_NEXT();
+
+        TURTLE_OP(YawPlus)
+            Push(RotateY(SumAngles(op->count)));
+            TURTLE_NEXT();
+
+        TURTLE_OP(YawMinus)
+            Push(RotateY(-SumAngles(op->count)));
+            TURTLE_NEXT();
+
+        TURTLE_OP(PitchPlus)
+            Push(Tilt(TiltX, 1.0f, op->count));
+            TURTLE_NEXT();
+
+        TURTLE_OP(PitchMinus)
+            Push(Tilt(TiltX, -1.0f, op->count));
+            TURTLE_NEXT();
+
+        TURTLE_OP(RollPlus)
+            Push(Tilt(TiltZ, 1.0f, op->count));
+            TURTLE_NEXT();
+
+        TURTLE_OP(RollMinus)
+            Push(Tilt(TiltZ, -1.0f, op->count));
+            TURTLE_NEXT();
+
+        TURTLE_OP(TurnAround)
+            Discard(op->count);
+            Push(k.turnAround);
+            TURTLE_NEXT();
+
+        TURTLE_OP(Pop)
+            Discard(1);
+            randomNum = static_cast<int>(floor(normalDistEndGen(gen)));
+            if ((op->flags & TurtleOp::FLAG_AFTER_MOVE) && randomNum == 0 || randomNum == -1) {
+                output.leafMatrices.push_back(stack.back() * k.leafTranslate * scalingStack.back());
+                skeleton.leafSegment.push_back(op->segment);
+            }
+            PopMatrices(stack, op->count);
+            PopMatrices(scalingStack, op->scalingCount);
+            TURTLE_NEXT();
+
+        TURTLE_OP(Skip)
+            Discard(op->count);
+            TURTLE_NEXT();
+
+        TURTLE_OP(End)
+            return true;
+    }
+#ifndef TURTLE_THREADED_DISPATCH
+    }
+#endif
+
+#undef TURTLE_REPORT
+#undef TURTLE_OP
+#undef TURTLE_DISPATCH
+#undef TURTLE_NEXT
+}
+
+} // namespace
+
+bool RunTurtleProgram(const TurtleProgram& program, const TurtleParams& params,
+    TurtleOutput& output, std::pmr::memory_resource* scratch,
+    std::atomic<float>* progress, const std::atomic<bool>* cancel) {
+    if (program.empty() || program.back().code != TurtleOpCode::End)
+        return false;
+
+    TurtleConstants k;
+    k.move = glm::scale(glm::mat4(1.0f), glm::vec3(params.radiusScaling, params.heightScaling, params.radiusScaling)) *
+        glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, params.cylinderHeight * (params.heightScaling + 1.0f) / 2.2f, 0.0f));
+    // 역행렬이 무조건 존재한다고 가정
+    k.scalingInverse = glm::scale(glm::mat4(1.0f), glm::vec3(1.0f / params.radiusScaling,
+        1.0f / params.heightScaling, 1.0f / params.radiusScaling));
+    k.leafTranslate = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, params.cylinderHeight / -2.0f, 0.0f));
+    k.turnAround = glm::rotate(glm::mat4(1.0f), glm::radians(180.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    // 원기둥은 y = -h/2 ~ h/2, 그릴 때 -h 만큼 내려서 그림 (LSystem::Draw)
+    k.segmentStart = glm::vec4(0.0f, -1.5f * params.cylinderHeight, 0.0f, 1.0f);
+    k.segmentEnd = glm::vec4(0.0f, -0.5f * params.cylinderHeight, 0.0f, 1.0f);
+    k.tiltPush = TILT_WEIGHT * params.cylinderHeight / 2.0f;
+
+    size_t segmentCount = 0;
+    for (auto& op : program) {
+        if (op.code == TurtleOpCode::Move)
+            segmentCount += op.count;
+    }
+    output.cylinderMatrices.clear();
+    output.leafMatrices.clear();
+    output.skeleton.Clear();
+    output.cylinderMatrices.reserve(segmentCount);
+    output.skeleton.Reserve(segmentCount);
+
+    if (progress || cancel)
+        return Run<true>(program, params, k, output, scratch, progress, cancel);
+    return Run<false>(program, params, k, output, scratch, progress, cancel);
+}
\ No newline at end of file
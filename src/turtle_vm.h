@@ -0,0 +1,40 @@
+#ifndef __TURTLE_VM_H__
+#define __TURTLE_VM_H__
+
+#include "core_common.h"
+#include "turtle_program.h"
+#include "tree_skeleton.h"
+#include <atomic>
+#include <memory_resource>
+#include <vector>
+
+// 해석에 필요한 나무 설정 (Tree의 멤버에서 채움)
+struct TurtleParams {
+    float angle { 30.0f };
+    float cylinderRadius { 0.1f };
+    float cylinderHeight { 1.0f };
+    float radiusScaling { 0.75f };
+    float heightScaling { 0.75f };
+    uint32_t seed { 0 };
+};
+
+struct TurtleOutput {
+    std::vector<glm::mat4> cylinderMatrices;
+    std::vector<glm::mat4> leafMatrices;
+    TreeSkeleton skeleton;
+};
+
+/*
+TurtleProgram을 실행하는 VM
+1. op마다 쓰는 상수 행렬 (가지 이동, 잎 크기 보정, 180도 회전 등)은 실행 전에 한 번만 계산
+2. GCC / Clang은 computed goto로 op마다 바로 다음 op로 분기 (threaded dispatch), 그 외는 switch
+3. 진행 상황 기록 여부는 template 인자 -> 반복문 안에서 분기하지 않음 (각도 난수는 항상 사용)
+같은 설정이면 이전의 문자 단위 해석과 같은 난수를 같은 순서로 뽑음
+결과는 나무의 local 좌표 (뿌리가 원점), 배치 위치는 Tree::GetPlacement
+progress / cancel이 nullptr가 아니면 진행 상황 (0.5 ~ 1)을 기록하고, 취소되면 false 반환
+*/
+bool RunTurtleProgram(const TurtleProgram& program, const TurtleParams& params,
+    TurtleOutput& output, std::pmr::memory_resource* scratch,
+    std::atomic<float>* progress = nullptr, const std::atomic<bool>* cancel = nullptr);
+
+#endif // __TURTLE_VM_H__
\ No newline at end of file
@@ -21,6 +21,8 @@ public:
                     uint32_t type, bool normalized,
                     size_t stride, uint64_t offset) const;
     void DisableAttrib(int attribIndex) const;
+    // divisor개의 instance마다 다음 값으로 넘어감 (0이면 정점마다)
+    void SetAttribDivisor(uint32_t attribIndex, uint32_t divisor) const;
 
 private:
     VertexLayout() {}
@@ -0,0 +1,210 @@
+#include "common.h"
+#include "lsystem.h"
+#include "model.h"
+#include "program.h"
+#include "tree.h"
+#include <cstdlib>
+#include <new>
+
+/*
+매 프레임 / 생성마다 불필요한 복사가 없는지 operator new 횟수로 확인
+treegen_alloc_test tree : Tree::Create가 axiom / rules를 복사하지 않고 옮기는지 (GL 없음)
+treegen_alloc_test gl   : LSystem::Create, Program::SetUniform, Mesh / Model 접근자
+                          (GL context를 만들 수 없으면 SKIP_CODE로 종료)
+*/
+
+namespace {
+
+const int SKIP_CODE = 77;
+const int REPEAT = 1000;
+
+// 다른 스레드 (ParallelFor 워커 등)의 할당은 세지 않음
+thread_local size_t t_allocCount = 0;
+
+#define ALLOC_CHECK(expr) \
+    do { \
+        if (!(expr)) { \
+            SPDLOG_ERROR("check failed: {}", #expr); \
+            return 1; \
+        } \
+    } while (0)
+
+// body를 repeat번 실행하는 동안의 할당 횟수
+template <typename Body>
+size_t CountAllocations(Body body, int repeat = REPEAT) {
+    size_t before = t_allocCount;
+    for (int i = 0; i < repeat; i++)
+        body();
+    return t_allocCount - before;
+}
+
+// SSO 버퍼보다 길어서 복사하면 heap 할당이 생기는 문자열
+const char* AXIOM = "FFFFFFFFFFFFFFFFFFFFA";
+const char* RULES = "A=F[--&&FC][++&&FC][--^FC][++^FC]\nC=F[<&&FC]||[>&&FC]";
+
+int TestTree() {
+    // 캐시를 쓰면 생성 경로의 할당이 달라짐
+    Tree::SetCache(nullptr);
+    std::vector<float> treeParam { 0.1f, 1.0f, 0.2f, 0.2f, 0.75f, 0.75f };
+    // 처음 한 번만 생기는 할당 (static 초기화 등)은 세지 않도록 먼저 한 번 생성
+    ALLOC_CHECK(Tree::Create(AXIOM, RULES, treeParam, 30.0f, 2, false, 0.0f, 0.0f, 0));
+
+    // 옮긴 문자열은 그대로 Tree의 멤버가 됨 (같은 버퍼)
+    std::string axiom = AXIOM;
+    std::string rules = RULES;
+    const char* axiomData = axiom.data();
+    const char* rulesData = rules.data();
+    TreeUPtr tree;
+    size_t moved = CountAllocations([&]() {
+        tree = Tree::Create(std::move(axiom), std::move(rules), treeParam, 30.0f, 2, false, 0.0f, 0.0f, 0);
+    }, 1);
+    ALLOC_CHECK(tree);
+    ALLOC_CHECK(tree->GetAxiom().data() == axiomData);
+    ALLOC_CHECK(tree->GetRules().data() == rulesData);
+
+    // 같은 나무를 복사한 문자열로 만들면 호출하는 쪽의 복사 두 번만 더 할당
+    std::string axiomCopy = AXIOM;
+    std::string rulesCopy = RULES;
+    tree.reset();
+    size_t copied = CountAllocations([&]() {
+        tree = Tree::Create(axiomCopy, rulesCopy, treeParam, 30.0f, 2, false, 0.0f, 0.0f, 0);
+    }, 1);
+    ALLOC_CHECK(tree);
+    SPDLOG_INFO("Tree::Create: {} allocations when moved, {} when copied", moved, copied);
+    ALLOC_CHECK(copied == moved + 2);
+    return 0;
+}
+
+int TestUniform() {
+    // 이름은 std::string의 SSO 버퍼보다 길게 (예전에는 매번 heap 할당)
+    auto vs = Shader::CreateFromSource(
+        "#version 330 core\n"
+        "layout (location = 0) in vec3 aPos;\n"
+        "uniform mat4 transformWithLongUniformName;\n"
+        "uniform vec4 colorWithLongUniformName;\n"
+        "out vec4 color;\n"
+        "void main() {\n"
+        "    gl_Position = transformWithLongUniformName * vec4(aPos, 1.0);\n"
+        "    color = colorWithLongUniformName;\n"
+        "}\n", GL_VERTEX_SHADER, "alloc_test.vs");
+    auto fs = Shader::CreateFromSource(
+        "#version 330 core\n"
+        "in vec4 color;\n"
+        "out vec4 fragColor;\n"
+        "void main() { fragColor = color; }\n", GL_FRAGMENT_SHADER, "alloc_test.fs");
+    ALLOC_CHECK(vs && fs);
+    auto program = Program::Create({ std::move(vs), std::move(fs) });
+    ALLOC_CHECK(program);
+
+    program->Use();
+    glm::mat4 transform(1.0f);
+    glm::vec4 color(1.0f);
+    size_t count = CountAllocations([&]() {
+        program->SetUniform("transformWithLongUniformName", transform);
+        program->SetUniform("colorWithLongUniformName", color);
+    });
+    SPDLOG_INFO("uniforms: {} allocations in {} frames", count, REPEAT);
+    ALLOC_CHECK(count == 0);
+    return 0;
+}
+
+// CPU 사본을 유지하는 mesh와 그 mesh를 가진 model의 접근자는 복사하지 않음
+int TestMeshAndModel() {
+    MeshPtr mesh = Mesh::CreateBox();
+    ALLOC_CHECK(mesh);
+    ALLOC_CHECK(mesh->GetCpuRetention() == CpuRetention::Retained);
+    size_t elements = 0;
+    size_t count = CountAllocations([&]() {
+        elements += mesh->GetVertices().size();
+        elements += mesh->GetIndices().size();
+    });
+    SPDLOG_INFO("Mesh::GetVertices / GetIndices: {} allocations in {} frames", count, REPEAT);
+    ALLOC_CHECK(elements > 0);
+    ALLOC_CHECK(count == 0);
+
+    auto model = Model::CreateFromMeshes({ mesh }, {});
+    ALLOC_CHECK(model);
+    elements = 0;
+    count = CountAllocations([&]() {
+        for (int i = 0; i < model->GetMeshCount(); i++)
+            elements += model->GetMesh(i)->GetIndices().size();
+    });
+    SPDLOG_INFO("Model accessors: {} allocations in {} frames", count, REPEAT);
+    ALLOC_CHECK(elements > 0);
+    ALLOC_CHECK(count == 0);
+    return 0;
+}
+
+// LSystem::Create도 axiom / rules를 Tree까지 복사 없이 옮김
+// (텍스쳐, 쉐이더를 불러오므로 할당 수 대신 버퍼가 같은지 확인)
+int TestLSystem() {
+    Tree::SetCache(nullptr);
+    std::vector<float> treeParam { 0.1f, 1.0f, 0.2f, 0.2f, 0.75f, 0.75f };
+    std::string axiom = AXIOM;
+    std::string rules = RULES;
+    const char* axiomData = axiom.data();
+    const char* rulesData = rules.data();
+    auto lsystem = LSystem::Create(std::move(axiom), std::move(rules), treeParam, 30.0f, 2, false, 0.0f, 0.0f, 0);
+    ALLOC_CHECK(lsystem);
+    ALLOC_CHECK(lsystem->GetAxiom().data() == axiomData);
+    ALLOC_CHECK(lsystem->GetRules().data() == rulesData);
+    return 0;
+}
+
+int TestGl() {
+    if (!glfwInit())
+        return SKIP_CODE;
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    auto window = glfwCreateWindow(16, 16, "alloc test", nullptr, nullptr);
+    if (!window) {
+        glfwTerminate();
+        return SKIP_CODE;
+    }
+    glfwMakeContextCurrent(window);
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        glfwDestroyWindow(window);
+        glfwTerminate();
+        return SKIP_CODE;
+    }
+
+    // GL 리소스는 context를 없애기 전에 해제
+    int result = TestUniform();
+    if (result == 0)
+        result = TestMeshAndModel();
+    if (result == 0)
+        result = TestLSystem();
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return result;
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    t_allocCount++;
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+int main(int argc, const char** argv) {
+    std::string test = argc > 1 ? argv[1] : "";
+    if (test == "tree")
+        return TestTree();
+    if (test == "gl")
+        return TestGl();
+    SPDLOG_ERROR("usage: treegen_alloc_test tree|gl");
+    return 1;
+}
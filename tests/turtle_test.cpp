@@ -0,0 +1,126 @@
+#include "tree.h"
+#include "tree_preset.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+/*
+문자열 -> turtle bytecode 변환 (TurtleProgram)과 VM 해석 (RunTurtleProgram) 결과가
+이전의 문자 단위 해석기와 같은지 확인
+기본 preset x iteration x seed 마다 segment / 잎 수, skeleton parent, 행렬 합을 비교
+기록된 값은 바이트코드 변환 이전의 문자 단위 해석기로 만든 값
+std::normal_distribution 등의 난수 분포는 표준 라이브러리마다 다르므로 libstdc++에서만 비교하고,
+그 외에는 skeleton 구조만 확인
+*/
+
+namespace {
+
+const double CHECKSUM_TOLERANCE = 1e-5;
+
+#define TURTLE_CHECK(expr) \
+    do { \
+        if (!(expr)) { \
+            SPDLOG_ERROR("{} iteration {} seed {}: check failed: {}", c.preset, c.iteration, c.seed, #expr); \
+            return false; \
+        } \
+    } while (0)
+
+struct TurtleCase {
+    const char* preset;
+    int iteration;
+    uint32_t seed;
+    size_t symbols;
+    size_t segments;
+    size_t leaves;
+    uint32_t parentHash;      // skeleton.parent의 FNV-1a
+    uint32_t leafSegmentHash; // skeleton.leafSegment의 FNV-1a
+    double cylinderSum;       // 가지 transform 12개 성분의 절댓값 합
+    double leafSum;           // 잎 transform 12개 성분의 절댓값 합
+};
+
+const TurtleCase CASES[] = {
+    { "ARROW_TREE", 3, 0, 833, 171, 69, 0xa9c58a39, 0x335cb383, 452.270090, 458.486552 },
+    { "ARROW_TREE", 3, 7, 833, 171, 70, 0xa9c58a39, 0xc9358fb7, 450.278772, 463.739278 },
+    { "ARROW_TREE", 5, 0, 13633, 2731, 1141, 0xdbd0b759, 0xb9fc788f, 6404.390658, 7603.876883 },
+    { "ARROW_TREE", 5, 7, 13633, 2731, 1127, 0xdbd0b759, 0x3a41da57, 6335.558653, 7491.776602 },
+    { "STOCHASTIC", 3, 0, 889, 211, 69, 0x91d4fae5, 0x84136f38, 544.300241, 464.443581 },
+    { "STOCHASTIC", 3, 7, 893, 211, 69, 0xf0b75445, 0x921526d4, 543.618128, 458.058291 },
+    { "STOCHASTIC", 5, 0, 14483, 3411, 1125, 0xf1cf3521, 0x83d473b9, 7911.040588, 7564.511185 },
+    { "STOCHASTIC", 5, 7, 14497, 3411, 1149, 0xde6755c9, 0xc32dda98, 7869.315909, 7691.196999 },
+    { "BUSH_LIKE", 3, 0, 76, 17, 10, 0x72b5f0d6, 0xb009b684, 57.070829, 66.695629 },
+    { "BUSH_LIKE", 3, 7, 76, 17, 12, 0x72b5f0d6, 0x830adeb5, 56.841065, 79.062773 },
+    { "BUSH_LIKE", 5, 0, 247, 53, 32, 0x0add9543, 0x516c70a2, 170.928645, 222.173366 },
+    { "BUSH_LIKE", 5, 7, 247, 53, 31, 0x0add9543, 0xb61986e6, 169.522380, 213.790558 },
+    { "BINARYTREE", 3, 0, 57, 15, 11, 0x5eec3a24, 0x36350f8b, 44.700112, 55.920328 },
+    { "BINARYTREE", 3, 7, 57, 15, 10, 0x5eec3a24, 0x5acbabc5, 45.046272, 50.881075 },
+    { "BINARYTREE", 5, 0, 249, 63, 42, 0x8ba5fc98, 0xb2aa37bf, 173.543577, 225.542365 },
+    { "BINARYTREE", 5, 7, 249, 63, 43, 0x8ba5fc98, 0xc1d256aa, 173.794783, 232.045151 },
+};
+
+uint32_t Hash(const std::vector<int32_t>& values) {
+    uint32_t hash = 2166136261u;
+    for (auto value : values)
+        hash = (hash ^ (uint32_t)value) * 16777619u;
+    return hash;
+}
+
+double Checksum(const TreeTransforms& transforms) {
+    double sum = 0.0;
+    float affine[TreeTransforms::FLOAT_COUNT];
+    for (size_t i = 0; i < transforms.count; i++) {
+        transforms.GetAffine(i, affine);
+        for (auto value : affine)
+            sum += std::fabs((double)value);
+    }
+    return sum;
+}
+
+bool IsClose(double value, double expected) {
+    return std::fabs(value - expected) <= CHECKSUM_TOLERANCE * std::max(1.0, std::fabs(expected));
+}
+
+bool RunCase(const TurtleCase& c) {
+    auto preset = FindTreePreset(c.preset);
+    TURTLE_CHECK(preset);
+    std::vector<float> treeParam { 0.1f, 1.0f, 0.2f, 0.2f, 0.75f, 0.75f };
+    auto tree = Tree::Create(preset->axiom, preset->rules, treeParam, 30.0f, c.iteration, false, 0.0f, 0.0f, c.seed);
+    TURTLE_CHECK(tree);
+
+    auto cylinders = tree->GetCylinderTransforms();
+    auto leaves = tree->GetLeafTransforms();
+    auto& skeleton = tree->GetSkeleton();
+    TURTLE_CHECK(skeleton.GetSegmentCount() == cylinders.count);
+    TURTLE_CHECK(skeleton.GetLeafCount() == leaves.count);
+    for (size_t i = 0; i < skeleton.GetSegmentCount(); i++)
+        TURTLE_CHECK(skeleton.parent[i] < (int32_t)i);
+    for (auto segment : skeleton.leafSegment)
+        TURTLE_CHECK(segment < (int32_t)skeleton.GetSegmentCount());
+
+#if defined(__GLIBCXX__)
+    TURTLE_CHECK(tree->GetCodes().size() == c.symbols);
+    TURTLE_CHECK(cylinders.count == c.segments);
+    TURTLE_CHECK(leaves.count == c.leaves);
+    TURTLE_CHECK(Hash(skeleton.parent) == c.parentHash);
+    TURTLE_CHECK(Hash(skeleton.leafSegment) == c.leafSegmentHash);
+    TURTLE_CHECK(IsClose(Checksum(cylinders), c.cylinderSum));
+    TURTLE_CHECK(IsClose(Checksum(leaves), c.leafSum));
+#endif
+    return true;
+}
+
+} // namespace
+
+int main() {
+    // 캐시에서 불러오면 해석기를 거치지 않음
+    Tree::SetCache(nullptr);
+#if !defined(__GLIBCXX__)
+    SPDLOG_WARN("recorded values need libstdc++ random distributions, checking skeleton structure only");
+#endif
+    int failed = 0;
+    for (auto& c : CASES) {
+        if (!RunCase(c))
+            failed++;
+    }
+    SPDLOG_INFO("turtle: {} of {} cases passed", std::size(CASES) - failed, std::size(CASES));
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,345 @@
+#include "tree.h"
+#include "tree_file.h"
+#include "tree_preset.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+/*
+창 없이 나무를 일괄 생성해서 OBJ / MTL로 저장
+iteration 범위 x seed 범위의 조합마다 작업 하나
+1. 메인 스레드가 작업을 크기가 정해진 큐에 넣음 (큐가 차면 대기)
+2. 워커 스레드가 작업을 꺼내서 생성 후 export
+3. 작업마다 예상 메모리를 미리 계산해서 budget을 넘으면 생성하지 않음
+
+treegen_batch --preset BINARYTREE --iterations 3-6 --seeds 0-4999 --out ./trees
+*/
+
+struct BatchOptions {
+    std::string axiom;
+    std::string rules;
+    int minIteration { 3 };
+    int maxIteration { 3 };
+    float angle { 30.0f };
+    // cylinderRadius, cylinderHeight, leafRadius, leafHeight, radiusScaling, heightScaling
+    std::vector<float> treeParam { 0.1f, 1.0f, 0.2f, 0.2f, 0.75f, 0.75f };
+    uint32_t minSeed { 0 };
+    uint32_t maxSeed { 0 };
+    bool sphere { false };
+    bool writeObj { true };
+    bool writeMtl { true };
+    bool writeTree { false };
+    bool quantize { false };
+    std::string outputDir { "." };
+    std::string texture;
+    std::string cacheDir;
+    size_t cacheSize { (size_t)1024 << 20 };
+    int jobs { (int)std::max(1u, std::thread::hardware_concurrency()) };
+    size_t queueSize { 0 };
+    size_t memoryBudget { (size_t)512 << 20 };
+};
+
+struct BatchJob {
+    int iteration;
+    uint32_t seed;
+};
+
+// 생산자가 너무 앞서가지 않도록 크기가 정해진 작업 큐
+template <typename T>
+class BoundedQueue {
+public:
+    BoundedQueue(size_t capacity) : m_capacity(std::max<size_t>(capacity, 1)) {}
+
+    void Push(const T& item) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notFull.wait(lock, [&] { return m_items.size() < m_capacity; });
+        m_items.push_back(item);
+        m_notEmpty.notify_one();
+    }
+
+    // 큐가 닫히고 비어있으면 false
+    bool Pop(T& item) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notEmpty.wait(lock, [&] { return !m_items.empty() || m_closed; });
+        if (m_items.empty())
+            return false;
+        item = m_items.front();
+        m_items.pop_front();
+        m_notFull.notify_one();
+        return true;
+    }
+
+    void Close() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+        m_notEmpty.notify_all();
+    }
+
+private:
+    size_t m_capacity;
+    bool m_closed { false };
+    std::deque<T> m_items;
+    std::mutex m_mutex;
+    std::condition_variable m_notFull;
+    std::condition_variable m_notEmpty;
+};
+
+static void PrintUsage() {
+    printf(
+        "usage: treegen_batch [options]\n"
+        "  --preset NAME        ARROW_TREE, STOCHASTIC, BUSH_LIKE, BINARYTREE\n"
+        "  --axiom STR          axiom (overrides preset)\n"
+        "  --rule STR           rule such as X=F[<X][>X], can be repeated (overrides preset)\n"
+        "  --iterations A[-B]   iteration range (default 3)\n"
+        "  --angle DEG          branch angle (default 30)\n"
+        "  --params r,h,lr,lh,rs,hs\n"
+        "                       cylinder radius/height, leaf radius/height, radius/height scaling\n"
+        "  --seeds A[-B]        seed range (default 0)\n"
+        "  --sphere             sphere leaves\n"
+        "  --format FORMAT      obj, obj+mtl, tgtree or tgtree-q (quantized transforms) (default obj+mtl)\n"
+        "  --texture PATH       copy bark texture to OUT/tree.png for the mtl files\n"
+        "  --out DIR            output directory (default .)\n"
+        "  --cache DIR          reuse / store generated trees in an on-disk cache\n"
+        "  --cache-size MB      cache size limit, least recently used files are removed (default 1024)\n"
+        "  --jobs N             worker threads (default: number of cores)\n"
+        "  --queue N            max queued jobs (default: 2 x jobs)\n"
+        "  --memory-budget MB   skip jobs estimated above this (default 512)\n");
+}
+
+static bool ParseRange(const std::string& text, long long& minValue, long long& maxValue) {
+    try {
+        auto pos = text.find('-', 1);
+        minValue = std::stoll(text.substr(0, pos));
+        maxValue = pos == std::string::npos ? minValue : std::stoll(text.substr(pos + 1));
+    }
+    catch (const std::exception&) {
+        return false;
+    }
+    return minValue <= maxValue;
+}
+
+static bool ParseOptions(int argc, char** argv, BatchOptions& options) {
+    std::vector<std::string> rules;
+    const TreePreset* preset = FindTreePreset("BINARYTREE");
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        auto NextValue = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                SPDLOG_ERROR("missing value for {}", arg);
+                return "";
+            }
+            return argv[++i];
+        };
+        long long minValue, maxValue;
+
+        if (arg == "--help" || arg == "-h") {
+            return false;
+        }
+        else if (arg == "--preset") {
+            preset = FindTreePreset(NextValue());
+            if (!preset) {
+                SPDLOG_ERROR("unknown preset: {}", argv[i]);
+                return false;
+            }
+        }
+        else if (arg == "--axiom") {
+            options.axiom = NextValue();
+        }
+        else if (arg == "--rule") {
+            rules.push_back(NextValue());
+        }
+        else if (arg == "--iterations") {
+            if (!ParseRange(NextValue(), minValue, maxValue) || minValue < 0) {
+                SPDLOG_ERROR("invalid iteration range: {}", argv[i]);
+                return false;
+            }
+            options.minIteration = (int)minValue;
+            options.maxIteration = (int)maxValue;
+        }
+        else if (arg == "--angle") {
+            options.angle = std::stof(NextValue());
+        }
+        else if (arg == "--params") {
+            std::istringstream ss(NextValue());
+            std::string token;
+            options.treeParam.clear();
+            while (std::getline(ss, token, ','))
+                options.treeParam.push_back(std::stof(token));
+            if (options.treeParam.size() != 6) {
+                SPDLOG_ERROR("--params needs 6 values");
+                return false;
+            }
+        }
+        else if (arg == "--seeds") {
+            if (!ParseRange(NextValue(), minValue, maxValue) || minValue < 0 || maxValue >= Tree::RANDOM_SEED) {
+                SPDLOG_ERROR("invalid seed range: {}", argv[i]);
+                return false;
+            }
+            options.minSeed = (uint32_t)minValue;
+            options.maxSeed = (uint32_t)maxValue;
+        }
+        else if (arg == "--sphere") {
+            options.sphere = true;
+        }
+        else if (arg == "--format") {
+            auto format = NextValue();
+            if (format != "obj" && format != "obj+mtl" && format != "tgtree" && format != "tgtree-q") {
+                SPDLOG_ERROR("unknown format: {}", format);
+                return false;
+            }
+            options.writeObj = format == "obj" || format == "obj+mtl";
+            options.writeMtl = format == "obj+mtl";
+            options.writeTree = format == "tgtree" || format == "tgtree-q";
+            options.quantize = format == "tgtree-q";
+        }
+        else if (arg == "--texture") {
+            options.texture = NextValue();
+        }
+        else if (arg == "--out") {
+            options.outputDir = NextValue();
+        }
+        else if (arg == "--cache") {
+            options.cacheDir = NextValue();
+        }
+        else if (arg == "--cache-size") {
+            options.cacheSize = (size_t)std::max(1, std::stoi(NextValue())) << 20;
+        }
+        else if (arg == "--jobs") {
+            options.jobs = std::max(1, std::stoi(NextValue()));
+        }
+        else if (arg == "--queue") {
+            options.queueSize = (size_t)std::max(1, std::stoi(NextValue()));
+        }
+        else if (arg == "--memory-budget") {
+            options.memoryBudget = (size_t)std::max(1, std::stoi(NextValue())) << 20;
+        }
+        else {
+            SPDLOG_ERROR("unknown option: {}", arg);
+            return false;
+        }
+    }
+
+    if (options.axiom.empty())
+        options.axiom = preset->axiom;
+    if (rules.empty()) {
+        options.rules = preset->rules;
+    }
+    else {
+        for (size_t i = 0; i < rules.size(); i++)
+            options.rules += (i > 0 ? "\n" : "") + rules[i];
+    }
+    if (options.queueSize == 0)
+        options.queueSize = (size_t)options.jobs * 2;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    BatchOptions options;
+    bool parsed = false;
+    try {
+        parsed = ParseOptions(argc, argv, options);
+    }
+    catch (const std::exception&) {
+        SPDLOG_ERROR("invalid number in arguments");
+    }
+    if (!parsed) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(options.outputDir, error);
+    if (error) {
+        SPDLOG_ERROR("failed to create output directory: {}", options.outputDir);
+        return 1;
+    }
+    if (options.writeMtl && !options.texture.empty()) {
+        std::filesystem::copy_file(options.texture, options.outputDir + "/tree.png",
+            std::filesystem::copy_options::overwrite_existing, error);
+        if (error)
+            SPDLOG_ERROR("failed to copy texture: {}", options.texture);
+    }
+
+    if (!options.cacheDir.empty())
+        Tree::SetCache(TreeCache::Create(options.cacheDir, options.cacheSize));
+
+    // iteration마다 seed와 상관없이 같은 상한이므로 미리 계산
+    std::vector<size_t> estimates;
+    for (int iteration = options.minIteration; iteration <= options.maxIteration; iteration++) {
+        estimates.push_back(Tree::EstimateMemoryUsage(options.axiom, options.rules, iteration, options.sphere));
+        if (estimates.back() > options.memoryBudget) {
+            SPDLOG_ERROR("iteration {} needs about {} MB, over the budget of {} MB, skipped",
+                iteration, estimates.back() >> 20, options.memoryBudget >> 20);
+        }
+    }
+
+    size_t seedCount = (size_t)options.maxSeed - options.minSeed + 1;
+    size_t total = seedCount * (size_t)(options.maxIteration - options.minIteration + 1);
+    SPDLOG_INFO("generating {} trees with {} jobs", total, options.jobs);
+
+    BoundedQueue<BatchJob> queue(options.queueSize);
+    std::atomic<size_t> done { 0 };
+    std::atomic<size_t> failed { 0 };
+    std::atomic<size_t> skipped { 0 };
+    auto start = std::chrono::steady_clock::now();
+
+    auto Worker = [&]() {
+        // 워커마다 arena 하나를 계속 재사용
+        auto arena = GenerationArena::Create();
+        BatchJob job;
+        while (queue.Pop(job)) {
+            if (estimates[job.iteration - options.minIteration] > options.memoryBudget) {
+                skipped++;
+                done++;
+                continue;
+            }
+
+            auto tree = Tree::Create(options.axiom, options.rules, options.treeParam, options.angle,
+                job.iteration, options.sphere, 0.0f, 0.0f, job.seed, nullptr, arena.get());
+            std::string filename = fmt::format("tree_i{}_s{}", job.iteration, job.seed);
+            std::string path = options.outputDir + "/" + filename;
+            bool success = tree != nullptr;
+            if (success && options.writeTree)
+                success = TreeFile::Write(path + ".tgtree", *tree, options.quantize);
+            if (success && options.writeObj) {
+                std::ofstream outObj(path + ".obj");
+                success = tree->ExportObj(outObj, filename);
+                if (success && options.writeMtl) {
+                    std::ofstream outMtl(path + ".mtl");
+                    success = tree->ExportMtl(outMtl, filename);
+                }
+            }
+            if (!success) {
+                SPDLOG_ERROR("failed to generate {}", filename);
+                failed++;
+            }
+
+            size_t count = ++done;
+            if (count % 100 == 0 || count == total)
+                SPDLOG_INFO("{} / {}", count, total);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < options.jobs; i++)
+        workers.emplace_back(Worker);
+
+    for (int iteration = options.minIteration; iteration <= options.maxIteration; iteration++) {
+        for (size_t seed = options.minSeed; seed <= options.maxSeed; seed++)
+            queue.Push(BatchJob { iteration, (uint32_t)seed });
+    }
+    queue.Close();
+    for (auto& worker : workers)
+        worker.join();
+
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    SPDLOG_INFO("done: {} written, {} failed, {} skipped by memory budget ({:.1f} s, {:.1f} trees/s)",
+        total - failed - skipped, (size_t)failed, (size_t)skipped, elapsed, (total - skipped) / std::max(elapsed, 1e-9));
+    if (auto cache = Tree::GetCache())
+        SPDLOG_INFO("cache: {} hits, {} misses", cache->GetHitCount(), cache->GetMissCount());
+    return failed > 0 ? 1 : 0;
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include "texture_file.h"
+#include <chrono>
+#include <filesystem>
+
+/*
+이미지를 미리 .tgtex로 변환 (프로그램은 처음 불러올 때 직접 변환하므로 없어도 동작)
+파일 이름은 경로 문자열로 정해지므로 프로그램에서 쓰는 경로 그대로 넘겨야 함
+--flip / --no-flip은 뒤에 오는 이미지에 적용 (skybox는 뒤집지 않음)
+
+treegen_texconv ./image/marble.jpg ./image/leaf2.png ./image/tree.png --no-flip ./image/skybox/right.jpg ...
+*/
+
+static void PrintUsage() {
+    printf(
+        "usage: treegen_texconv [options] image...\n"
+        "  --out DIR            output directory (default ./cache/texture)\n"
+        "  --compress           BC1 for RGB, BC4 for single channel images (others stay raw)\n"
+        "  --flip               flip following images vertically (default)\n"
+        "  --no-flip            do not flip following images\n");
+}
+
+int main(int argc, char** argv) {
+    std::string outputDir = "./cache/texture";
+    bool compress = false;
+    bool flipVertical = true;
+    std::vector<std::pair<std::string, bool>> images;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--out" && i + 1 < argc)
+            outputDir = argv[++i];
+        else if (arg == "--compress")
+            compress = true;
+        else if (arg == "--flip")
+            flipVertical = true;
+        else if (arg == "--no-flip")
+            flipVertical = false;
+        else if (arg.size() > 1 && arg[0] == '-' && arg[1] == '-') {
+            SPDLOG_ERROR("unknown option: {}", arg);
+            PrintUsage();
+            return 1;
+        }
+        else
+            images.push_back({ arg, flipVertical });
+    }
+    if (images.empty()) {
+        PrintUsage();
+        return 1;
+    }
+
+    int failed = 0;
+    for (auto& [path, flip] : images) {
+        auto start = std::chrono::steady_clock::now();
+        auto file = TextureFile::LoadOrConvert(outputDir, path, flip, compress);
+        auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+        if (!file) {
+            failed++;
+            continue;
+        }
+        size_t size = 0;
+        for (int level = 0; level < file->GetLevelCount(); level++)
+            size += file->GetLevel(level).size;
+        SPDLOG_INFO("{}: {}x{}, {} levels, {} KB ({:.1f} ms)", path, file->GetWidth(), file->GetHeight(),
+            file->GetLevelCount(), size >> 10, elapsed.count());
+    }
+    return failed > 0 ? 1 : 0;
+}
\ No newline at end of file